@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * aes_ce_glue.c - AES-CBC decryption using ARMv8 Crypto Extensions
+ */
+
+#include <errno.h>
+#include <uboot_aes.h>
+#include <asm/system.h>
+
+extern void aes_armv8_ce_cbc_decrypt(u8 const *key_exp, u32 rounds,
+				     u8 const *iv, u8 const *src, u8 *dst,
+				     u32 blocks);
+
+/* The Crypto Extensions are optional, so check for them each time */
+static bool aes_ce_present(void)
+{
+	u64 reg;
+
+	asm volatile("mrs %0, ID_AA64ISAR0_EL1" : "=r" (reg));
+
+	return reg & ID_AA64ISAR0_EL1_AES;
+}
+
+int aes_arch_cbc_decrypt_blocks(u32 key_len, u8 *key_exp, u8 *iv, u8 *src,
+				u8 *dst, u32 num_aes_blocks)
+{
+	if (!aes_ce_present())
+		return -ENOSYS;
+
+	/* 10, 12 or 14 rounds for 128-, 192- and 256-bit keys */
+	if (num_aes_blocks)
+		aes_armv8_ce_cbc_decrypt(key_exp, key_len / 4 + 6, iv, src,
+					 dst, num_aes_blocks);
+
+	return 0;
+}
@@ -613,8 +613,8 @@ static int stm32_tamp_nvram_probe(struct udevice *dev)
 {
 	struct stm32_tamp_nvram_plat *plat = dev_get_plat(dev);
 	struct stm32_tamp_nvram_priv *priv = dev_get_priv(dev);
-	struct regmap_config config_regmap;
-	struct regmap_config bckreg_regmap;
+	struct regmap_config config_regmap = {};
+	struct regmap_config bckreg_regmap = {};
 	const struct stm32_tamp_nvram_drvdata *drvdata =
 		(struct stm32_tamp_nvram_drvdata *)dev_get_driver_data(dev);
 
@@ -598,7 +598,7 @@ static inline bool supports_extension(char ext)
 #if CONFIG_IS_ENABLED(RISCV_MMODE)
 	return csr_read(CSR_MISA) & (1 << (ext - 'a'));
 #elif CONFIG_CPU
-	return __riscv_isa_extension_available(ext);
+	return __riscv_isa_extension_available(ext - 'a');
 #else  /* !CONFIG_CPU */
 #warning "There is no way to determine the available extensions in S-mode."
 #warning "Please convert your board to use the RISC-V CPU driver."
@@ -661,6 +661,14 @@ int riscv_cpu_setup(void)
 		csr_write(CSR_FCSR, 0);
 	}
 
+	/* Enable the vector unit, which the memory routines check for */
+	if (IS_ENABLED(CONFIG_RISCV_ISA_V) && supports_extension('v'))
+		csr_set(MODE_PREFIX(status), SR_VS);
+
+	if (IS_ENABLED(CONFIG_RISCV_ISA_ZBC) &&
+	    !__riscv_isa_extension_available(RISCV_ISA_EXT_ZBC))
+		log_warning("Built for Zbc, but it is not in the devicetree\n");
+
 	if (CONFIG_IS_ENABLED(RISCV_MMODE)) {
 		/*
 		 * Enable perf counters for cycle, time,
@@ -60,6 +60,23 @@ void handle_ipi(ulong hart);
  */
 int smp_call_function(ulong addr, ulong arg0, ulong arg1, int wait);
 
+/**
+ * smp_call_function_count() - Call a function on all other harts and count them
+ *
+ * This is the same as smp_call_function() but also reports how many harts were
+ * sent the request, so that the caller can wait for them to finish.
+ *
+ * @addr: Address of function
+ * @arg0: First argument of function
+ * @arg1: Second argument of function
+ * @wait: Wait for harts to acknowledge request
+ * @countp: Returns the number of harts which were sent the request, which is
+ *	valid even if an error is returned
+ * Return: 0 if OK, -ve on error
+ */
+int smp_call_function_count(ulong addr, ulong arg0, ulong arg1, int wait,
+			    int *countp);
+
 /**
  * riscv_init_ipi() - Initialize inter-process interrupt (IPI) driver
  *
@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+/*
+ * Selection of the vector (RVV) memory routines
+ */
+
+#ifndef _ASM_RISCV_VECTOR_H
+#define _ASM_RISCV_VECTOR_H
+
+#include <asm/encoding.h>
+
+/* Shortest copy or fill worth setting up the vector unit for */
+#define RISCV_VECTOR_MIN_LEN	32
+
+#ifdef __ASSEMBLY__
+
+/*
+ * vector_dispatch - Jump to a vector routine if this hart can run it
+ *
+ * riscv_cpu_setup() turns on the vector unit of the boot hart when the
+ * devicetree reports the V extension, so the status register tells us whether
+ * vector instructions may be used here. Other harts, and the boot hart before
+ * that point, fall through to the scalar code which follows.
+ *
+ * @target: Vector routine, taking the same arguments as the caller
+ * @tmp: Scratch register
+ */
+.macro	vector_dispatch target, tmp
+	sltiu	\tmp, a2, RISCV_VECTOR_MIN_LEN
+	bnez	\tmp, 9999f
+	csrr	\tmp, MODE_PREFIX(status)
+	andi	\tmp, \tmp, SR_VS
+	beqz	\tmp, 9999f
+	j	\target
+9999:
+.endm
+
+#endif /* __ASSEMBLY__ */
+
+#endif /* _ASM_RISCV_VECTOR_H */
@@ -13,12 +13,14 @@
 
 DECLARE_GLOBAL_DATA_PTR;
 
-static int send_ipi_many(struct ipi_data *ipi, int wait)
+static int send_ipi_many(struct ipi_data *ipi, int wait, int *countp)
 {
 	ofnode node, cpus;
 	u32 reg;
 	int ret, pending;
 
+	*countp = 0;
+
 	cpus = ofnode_path("/cpus");
 	if (!ofnode_valid(cpus)) {
 		pr_err("Can't find cpus node!\n");
@@ -70,6 +72,7 @@ static int send_ipi_many(struct ipi_data *ipi, int wait)
 			pr_err("Cannot send IPI to hart %d\n", reg);
 			return ret;
 		}
+		(*countp)++;
 
 		if (wait) {
 			pending = 1;
@@ -117,6 +120,14 @@ void handle_ipi(ulong hart)
 }
 
 int smp_call_function(ulong addr, ulong arg0, ulong arg1, int wait)
+{
+	int count;
+
+	return smp_call_function_count(addr, arg0, arg1, wait, &count);
+}
+
+int smp_call_function_count(ulong addr, ulong arg0, ulong arg1, int wait,
+			    int *countp)
 {
 	struct ipi_data ipi = {
 		.addr = addr,
@@ -124,5 +135,5 @@ int smp_call_function(ulong addr, ulong arg0, ulong arg1, int wait)
 		.arg1 = arg1,
 	};
 
-	return send_ipi_many(&ipi, wait);
+	return send_ipi_many(&ipi, wait, countp);
 }
@@ -174,6 +174,14 @@ void sandbox_get_codec_params(struct udevice *dev, int *interfacep, int *ratep,
  */
 int sandbox_get_i2s_sum(struct udevice *dev);
 
+/**
+ * sandbox_hash_get_count() - Read back the number of hashes an engine started
+ *
+ * @dev: Device to check
+ * Return: number of one-shot and progressive hashes started
+ */
+int sandbox_hash_get_count(struct udevice *dev);
+
 /**
  * sandbox_get_setup_called() - Returns the number of times setup(*) was called
  *
@@ -361,4 +369,15 @@ bool sandbox_sf_bootdev_enabled(void);
  */
 void sandbox_sf_set_enable_bootdevs(bool enable);
 
+/**
+ * sandbox_mmc_set_emmc() - Make a sandbox MMC emulate a slow eMMC
+ *
+ * The device then behaves as an eMMC version 1.2, which reports busy to
+ * MMC_CMD_SEND_OP_COND for a number of polls before becoming ready
+ *
+ * @dev: MMC device to update
+ * @busy_polls: Number of MMC_CMD_SEND_OP_COND polls which report busy
+ */
+void sandbox_mmc_set_emmc(struct udevice *dev, int busy_polls);
+
 #endif
@@ -22,6 +22,7 @@
 #include <asm/cache.h>
 #include <asm/global_data.h>
 #include <asm/io.h>
+#include <dm/root.h>
 #include <linux/sizes.h>
 #include <tpm-v2.h>
 #include <tpm_tcg2.h>
@@ -1079,6 +1080,10 @@ int bootm_run_states(struct bootm_info *bmi, int states)
 		ret = boot_fn(BOOTM_STATE_OS_PREP, bmi);
 	}
 
+	/* Record the slowest drivers before bootstage is handed to the OS */
+	if (!ret && (states & (BOOTM_STATE_OS_FAKE_GO | BOOTM_STATE_OS_GO)))
+		dm_timing_add_bootstage();
+
 #ifdef CONFIG_TRACE
 	/* Pretend to run the OS, then run a user command */
 	if (!ret && (states & BOOTM_STATE_OS_FAKE_GO)) {
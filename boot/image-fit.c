@@ -1265,33 +1265,25 @@ int fit_set_timestamp(void *fit, int noffset, time_t timestamp)
 int calculate_hash(const void *data, int data_len, const char *name,
 			uint8_t *value, int *value_len)
 {
+	struct hash_algo *algo;
+	int ret;
 #if !defined(USE_HOSTCC) && defined(CONFIG_DM_HASH)
-	int rc;
 	enum HASH_ALGO hash_algo;
 	struct udevice *dev;
 
-	rc = uclass_get_device(UCLASS_HASH, 0, &dev);
-	if (rc) {
-		debug("failed to get hash device, rc=%d\n", rc);
-		return -1;
-	}
-
+	/* Use a hash engine if there is one worth using for this size */
 	hash_algo = hash_algo_lookup_by_name(name);
-	if (hash_algo == HASH_ALGO_INVALID) {
-		debug("Unsupported hash algorithm\n");
-		return -1;
-	};
-
-	rc = hash_digest_wd(dev, hash_algo, data, data_len, value, CHUNKSZ);
-	if (rc) {
-		debug("failed to get hash value, rc=%d\n", rc);
-		return -1;
+	if (hash_algo != HASH_ALGO_INVALID &&
+	    !hash_find_device(hash_algo, data_len, &dev)) {
+		ret = hash_digest_wd(dev, hash_algo, data, data_len, value,
+				     CHUNKSZ);
+		if (!ret) {
+			*value_len = hash_algo_digest_size(hash_algo);
+			return 0;
+		}
+		debug("failed to get hash value, rc=%d\n", ret);
 	}
-
-	*value_len = hash_algo_digest_size(hash_algo);
-#else
-	struct hash_algo *algo;
-	int ret;
+#endif
 
 	ret = hash_lookup_algo(name, &algo);
 	if (ret < 0) {
@@ -1301,13 +1293,13 @@ int calculate_hash(const void *data, int data_len, const char *name,
 
 	algo->hash_func_ws(data, data_len, value, algo->chunk_size);
 	*value_len = algo->digest_size;
-#endif
 
 	return 0;
 }
 
 static int fit_image_check_hash(const void *fit, int noffset, const void *data,
-				size_t size, char **err_msgp)
+				size_t size, const struct hash_stream *hs,
+				char **err_msgp)
 {
 	ALLOC_CACHE_ALIGN_BUFFER(uint8_t, value, FIT_MAX_HASH_LEN);
 	int value_len;
@@ -1338,7 +1330,12 @@ static int fit_image_check_hash(const void *fit, int noffset, const void *data,
 		return -1;
 	}
 
-	if (calculate_hash(data, size, algo, value, &value_len)) {
+	/* Use the digest calculated while loading, if it covers the data */
+	if (hs && hs->done && !hs->failed && hs->size == size &&
+	    !strcmp(hs->algo->name, algo)) {
+		memcpy(value, hs->digest, hs->digest_size);
+		value_len = hs->digest_size;
+	} else if (calculate_hash(data, size, algo, value, &value_len)) {
 		*err_msgp = "Unsupported hash algorithm";
 		return -1;
 	}
@@ -1354,9 +1351,9 @@ static int fit_image_check_hash(const void *fit, int noffset, const void *data,
 	return 0;
 }
 
-int fit_image_verify_with_data(const void *fit, int image_noffset,
-			       const void *key_blob, const void *data,
-			       size_t size)
+int fit_image_verify_with_stream(const void *fit, int image_noffset,
+				 const void *key_blob, const void *data,
+				 size_t size, const struct hash_stream *hs)
 {
 	int		noffset = 0;
 	char		*err_msg = "";
@@ -1382,7 +1379,7 @@ int fit_image_verify_with_data(const void *fit, int image_noffset,
 		 */
 		if (!strncmp(name, FIT_HASH_NODENAME,
 			     strlen(FIT_HASH_NODENAME))) {
-			if (fit_image_check_hash(fit, noffset, data, size,
+			if (fit_image_check_hash(fit, noffset, data, size, hs,
 						 &err_msg))
 				goto error;
 			puts("+ ");
@@ -1419,6 +1416,14 @@ error:
 	return 0;
 }
 
+int fit_image_verify_with_data(const void *fit, int image_noffset,
+			       const void *key_blob, const void *data,
+			       size_t size)
+{
+	return fit_image_verify_with_stream(fit, image_noffset, key_blob, data,
+					    size, NULL);
+}
+
 /**
  * fit_image_verify - verify data integrity
  * @fit: pointer to the FIT format image header
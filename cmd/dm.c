@@ -48,6 +48,29 @@ static int do_dm_dump_mem(struct cmd_tbl *cmdtp, int flag, int argc,
 }
 #endif /* DM_STATS */
 
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+static int do_dm_probe(struct cmd_tbl *cmdtp, int flag, int argc,
+		       char *const argv[])
+{
+	int ret;
+
+	ret = dm_lazy_bind_all();
+	if (ret < 0) {
+		printf("Failed to bind devices (err=%d)\n", ret);
+		return CMD_RET_FAILURE;
+	}
+	printf("Bound %d deferred node%s\n", ret, ret == 1 ? "" : "s");
+
+	ret = dm_autoprobe();
+	if (ret) {
+		printf("Failed to probe devices (err=%d)\n", ret);
+		return CMD_RET_FAILURE;
+	}
+
+	return 0;
+}
+#endif /* DM_LAZY_BIND */
+
 static int do_dm_dump_static_driver_info(struct cmd_tbl *cmdtp, int flag,
 					 int argc, char * const argv[])
 {
@@ -59,7 +82,7 @@ static int do_dm_dump_static_driver_info(struct cmd_tbl *cmdtp, int flag,
 static int do_dm_dump_tree(struct cmd_tbl *cmdtp, int flag, int argc,
 			   char *const argv[])
 {
-	bool extended = false, sort = false;
+	bool extended = false, sort = false, timing = false;
 	char *device = NULL;
 
 	for (; argc > 1; argc--, argv++) {
@@ -70,6 +93,9 @@ static int do_dm_dump_tree(struct cmd_tbl *cmdtp, int flag, int argc,
 			extended = true;
 		} else if (!strcmp(argv[1], "-s")) {
 			sort = true;
+		} else if (CONFIG_IS_ENABLED(DM_TIMING) &&
+			   !strcmp(argv[1], "-t")) {
+			timing = true;
 		} else {
 			printf("Unknown parameter: %s\n", argv[1]);
 			return 0;
@@ -78,7 +104,7 @@ static int do_dm_dump_tree(struct cmd_tbl *cmdtp, int flag, int argc,
 	if (argc > 1)
 		device = argv[1];
 
-	dm_dump_tree(device, extended, sort);
+	dm_dump_tree(device, extended, sort, timing);
 
 	return 0;
 }
@@ -104,6 +130,21 @@ static int do_dm_dump_uclass(struct cmd_tbl *cmdtp, int flag, int argc,
 	return 0;
 }
 
+#if CONFIG_IS_ENABLED(DM_TIMING)
+#define DM_TREE_HELP	"dm tree [-s][-e][-t][name]   Dump tree of driver model devices\n" \
+			"                 (-s=sort, -t=show time and memory)\n"
+#else
+#define DM_TREE_HELP	"dm tree [-s][-e][name]   Dump tree of driver model devices (-s=sort)\n"
+#endif
+
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+#define DM_PROBE_HELP	"dm probe         Bind all deferred devices and probe those which need it\n"
+#define DM_PROBE	U_BOOT_SUBCMD_MKENT(probe, 1, 1, do_dm_probe),
+#else
+#define DM_PROBE_HELP
+#define DM_PROBE
+#endif
+
 #if CONFIG_IS_ENABLED(DM_STATS)
 #define DM_MEM_HELP	"dm mem           Provide a summary of memory usage\n"
 #define DM_MEM		U_BOOT_SUBCMD_MKENT(mem, 1, 1, do_dm_dump_mem),
@@ -117,8 +158,9 @@ U_BOOT_LONGHELP(dm,
 	"dm devres        Dump list of device resources for each device\n"
 	"dm drivers       Dump list of drivers with uclass and instances\n"
 	DM_MEM_HELP
+	DM_PROBE_HELP
 	"dm static        Dump list of drivers with static platform data\n"
-	"dm tree [-s][-e][name]   Dump tree of driver model devices (-s=sort)\n"
+	DM_TREE_HELP
 	"dm uclass [-e][name]     Dump list of instances for each uclass");
 
 U_BOOT_CMD_WITH_SUBCMDS(dm, "Driver model low level access", dm_help_text,
@@ -126,6 +168,7 @@ U_BOOT_CMD_WITH_SUBCMDS(dm, "Driver model low level access", dm_help_text,
 	U_BOOT_SUBCMD_MKENT(devres, 1, 1, do_dm_dump_devres),
 	U_BOOT_SUBCMD_MKENT(drivers, 1, 1, do_dm_dump_drivers),
 	DM_MEM
+	DM_PROBE
 	U_BOOT_SUBCMD_MKENT(static, 1, 1, do_dm_dump_static_driver_info),
-	U_BOOT_SUBCMD_MKENT(tree, 4, 1, do_dm_dump_tree),
+	U_BOOT_SUBCMD_MKENT(tree, 5, 1, do_dm_dump_tree),
 	U_BOOT_SUBCMD_MKENT(uclass, 3, 1, do_dm_dump_uclass));
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Show information about the malloc() pool
+ */
+
+#include <command.h>
+#include <malloc.h>
+#include <time.h>
+
+/* Time and counts when the information was last shown */
+static ulong malloc_last_time;
+static ulong malloc_last_count;
+static ulong free_last_count;
+
+static void show_rate(const char *name, ulong count, ulong last,
+		      ulong elapsed)
+{
+	printf("%-14s%lu", name, count);
+	if (elapsed)
+		printf(" (%lu/s)", (count - last) * 1000 / elapsed);
+	putc('\n');
+}
+
+static int do_malloc_info(struct cmd_tbl *cmdtp, int flag, int argc,
+			  char *const argv[])
+{
+	struct malloc_info info;
+	ulong elapsed;
+
+	malloc_get_info(&info);
+	elapsed = get_timer(malloc_last_time);
+
+	printf("%-14s%lx\n", "total bytes", info.total_bytes);
+	printf("%-14s%lx\n", "in use bytes", info.in_use_bytes);
+	printf("%-14s%lx in %lu chunks\n", "free bytes", info.free_bytes,
+	       info.free_chunks);
+	printf("%-14s%lx\n", "largest free", info.largest_free);
+	if (info.free_bytes)
+		printf("%-14s%lu%%\n", "fragmented",
+		       100 - info.largest_free * 100 / info.free_bytes);
+	if (IS_ENABLED(CONFIG_SYS_MALLOC_SMALL)) {
+		printf("%-14s%lx in %lu chunks\n", "small cache",
+		       info.small_bytes, info.small_chunks);
+		printf("%-14s%lu", "small hits", info.small_hits);
+		if (info.malloc_count)
+			printf(" (%lu%%)",
+			       info.small_hits * 100 / info.malloc_count);
+		putc('\n');
+	}
+	show_rate("mallocs", info.malloc_count, malloc_last_count, elapsed);
+	show_rate("frees", info.free_count, free_last_count, elapsed);
+
+	malloc_last_time = get_timer(0);
+	malloc_last_count = info.malloc_count;
+	free_last_count = info.free_count;
+
+	return 0;
+}
+
+U_BOOT_LONGHELP(malloc,
+	"info - show information about the malloc() pool");
+
+U_BOOT_CMD_WITH_SUBCMDS(malloc, "malloc() pool", malloc_help_text,
+	U_BOOT_SUBCMD_MKENT(info, 1, 1, do_malloc_info));
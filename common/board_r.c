@@ -264,6 +264,9 @@ static int initr_dm(void)
 #ifdef CONFIG_TIMER
 	gd->timer = NULL;
 #endif
+	gd_set_uclass_table(NULL);
+	gd_set_dm_compat_index(NULL, 0);
+	gd_set_dm_pool(NULL);
 	bootstage_start(BOOTSTAGE_ID_ACCUM_DM_R, "dm_r");
 	ret = dm_init_and_scan(false);
 	bootstage_accum(BOOTSTAGE_ID_ACCUM_DM_R);
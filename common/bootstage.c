@@ -220,6 +220,35 @@ uint32_t bootstage_accum(enum bootstage_id id)
 	return duration;
 }
 
+int bootstage_add_accum(const char *name, uint32_t time_us)
+{
+	struct bootstage_data *data = gd->bootstage;
+	struct bootstage_record *rec, *end;
+
+	if (!data)
+		return 0;
+	for (rec = data->record, end = rec + data->rec_count; rec < end;
+	     rec++) {
+		if (rec->start_us && rec->name && !strcmp(rec->name, name))
+			break;
+	}
+	if (rec == end) {
+		if (data->rec_count == RECORD_COUNT) {
+			log_warning("Bootstage space exhausted\n");
+			return -ENOSPC;
+		}
+		rec = &data->record[data->rec_count++];
+		rec->id = data->next_id++;
+		rec->name = name;
+		rec->flags = 0;
+	}
+	/* A non-zero start time marks this as an accumulated record */
+	rec->start_us = timer_get_boot_us() ?: 1;
+	rec->time_us = time_us;
+
+	return 0;
+}
+
 /**
  * Get a record name as a printable string
  *
@@ -570,6 +570,7 @@ static mbinptr av_[NAV * 2 + 2] = {
 #ifdef CONFIG_SYS_MALLOC_DEFAULT_TO_INIT
 static void malloc_init(void);
 #endif
+static void malloc_small_reset(void);
 
 ulong mem_malloc_start = 0;
 ulong mem_malloc_end = 0;
@@ -578,6 +579,11 @@ ulong mem_malloc_brk = 0;
 static bool malloc_testing;	/* enable test mode */
 static int malloc_max_allocs;	/* return NULL after this many calls to malloc() */
 
+/* Number of calls, reported by malloc_get_info() */
+static ulong malloc_count;
+static ulong free_count;
+static ulong small_hits;
+
 void *sbrk(ptrdiff_t increment)
 {
 	ulong old = mem_malloc_brk;
@@ -608,6 +614,11 @@ void mem_malloc_init(ulong start, ulong size)
 	malloc_init();
 #endif
 
+	malloc_small_reset();
+	malloc_count = 0;
+	free_count = 0;
+	small_hits = 0;
+
 	debug("using memory %#lx-%#lx for malloc()\n", mem_malloc_start,
 	      mem_malloc_end);
 #if CONFIG_IS_ENABLED(SYS_MALLOC_CLEAR_ON_INIT)
@@ -1178,6 +1189,119 @@ static void malloc_extend_top(nb) INTERNAL_SIZE_T nb;
   assert(((unsigned long)((char*)top + top_size) & (pagesz - 1)) == 0);
 }
 
+/*
+  Small-chunk cache
+
+    Freed chunks of up to CONFIG_SYS_MALLOC_SMALL_MAX bytes are put on a
+    list for their size, instead of being coalesced and binned. They stay
+    in use as far as the rest of malloc is concerned, so handing one out
+    again needs no searching, splitting or unlinking. Each list holds at
+    most SMALL_DEPTH chunks, and all of them are given back if malloc
+    runs out of memory.
+*/
+
+#if CONFIG_IS_ENABLED(SYS_MALLOC_SMALL)
+
+#ifdef MCHECK_HEAP_PROTECTION
+static void fREe_impl(Void_t *mem);
+#endif
+
+#define SMALL_MAX_CHUNK  request2size(CONFIG_SYS_MALLOC_SMALL_MAX)
+#define SMALL_LISTS      ((SMALL_MAX_CHUNK - MINSIZE) / MALLOC_ALIGNMENT + 1)
+#define SMALL_DEPTH      16
+
+#define small_index(sz)  (((sz) - MINSIZE) / MALLOC_ALIGNMENT)
+
+static mchunkptr small_list[SMALL_LISTS];
+static unsigned char small_count[SMALL_LISTS];
+static bool small_flushing;
+
+static void malloc_small_reset(void)
+{
+  memset(small_list, '\0', sizeof(small_list));
+  memset(small_count, '\0', sizeof(small_count));
+}
+
+static mchunkptr malloc_small_get(INTERNAL_SIZE_T nb)
+{
+  int idx = small_index(nb);
+  mchunkptr p = small_list[idx];
+
+  if (p)
+  {
+    small_list[idx] = p->fd;
+    small_count[idx]--;
+    small_hits++;
+  }
+
+  return p;
+}
+
+static bool malloc_small_put(mchunkptr p, INTERNAL_SIZE_T sz)
+{
+  int idx;
+
+  if (sz > SMALL_MAX_CHUNK || small_flushing)
+    return false;
+  idx = small_index(sz);
+  if (small_count[idx] >= SMALL_DEPTH)
+    return false;
+  p->fd = small_list[idx];
+  small_list[idx] = p;
+  small_count[idx]++;
+
+  return true;
+}
+
+/* Get the number of bytes in cached chunks */
+static INTERNAL_SIZE_T malloc_small_bytes(void)
+{
+  INTERNAL_SIZE_T bytes = 0;
+  int i;
+
+  for (i = 0; i < SMALL_LISTS; i++)
+    bytes += small_count[i] * (MINSIZE + i * MALLOC_ALIGNMENT);
+
+  return bytes;
+}
+
+/* Free all cached chunks properly, returning the number freed */
+static int malloc_small_flush(void)
+{
+  mchunkptr p;
+  int i, count = 0;
+
+  small_flushing = true;
+  for (i = 0; i < SMALL_LISTS; i++)
+  {
+    while ((p = small_list[i]))
+    {
+      small_list[i] = p->fd;
+      VALGRIND_MALLOCLIKE_BLOCK(chunk2mem(p), 0, SIZE_SZ, false);
+      fREe_impl(chunk2mem(p));
+      count++;
+    }
+    small_count[i] = 0;
+  }
+  small_flushing = false;
+  free_count -= count;
+
+  return count;
+}
+
+#else
+
+static void malloc_small_reset(void)
+{
+}
+
+static inline INTERNAL_SIZE_T malloc_small_bytes(void)
+{
+  return 0;
+}
+
+#endif /* SYS_MALLOC_SMALL */
+
 /* Main public routines */
 
 /*
@@ -1280,6 +1404,16 @@ Void_t* mALLOc_impl(bytes) size_t bytes;
      return NULL;
 
   nb = request2size(bytes);  /* padded request size; */
+  malloc_count++;
+
+#if CONFIG_IS_ENABLED(SYS_MALLOC_SMALL)
+  if (nb <= SMALL_MAX_CHUNK && (victim = malloc_small_get(nb)))
+  {
+    check_inuse_chunk(victim);
+    VALGRIND_MALLOCLIKE_BLOCK(chunk2mem(victim), bytes, SIZE_SZ, false);
+    return chunk2mem(victim);
+  }
+#endif
 
   /* Check for exact match in a bin */
 
@@ -1486,7 +1620,17 @@ Void_t* mALLOc_impl(bytes) size_t bytes;
     /* Try to extend */
     malloc_extend_top(nb);
     if ( (remainder_size = chunksize(top) - nb) < (long)MINSIZE)
+    {
+#if CONFIG_IS_ENABLED(SYS_MALLOC_SMALL)
+      /* Give back the cached small chunks and try again */
+      if (malloc_small_flush())
+      {
+	malloc_count--;
+	return mALLOc_impl(bytes);
+      }
+#endif
       return NULL; /* propagate failure */
+    }
   }
 
   victim = top;
@@ -1561,8 +1705,16 @@ void fREe_impl(mem) Void_t* mem;
 #endif
 
   check_inuse_chunk(p);
+  free_count++;
 
   sz = hd & ~PREV_INUSE;
+#if CONFIG_IS_ENABLED(SYS_MALLOC_SMALL)
+  if (malloc_small_put(p, sz))
+  {
+    VALGRIND_FREELIKE_BLOCK(mem, SIZE_SZ);
+    return;
+  }
+#endif
   next = chunk_at_offset(p, sz);
   nextsz = chunksize(next);
   VALGRIND_FREELIKE_BLOCK(mem, SIZE_SZ);
@@ -1869,6 +2021,7 @@ Void_t* rEALLOc_impl(oldmem, bytes) Void_t* oldmem; size_t bytes;
     VALGRIND_MALLOCLIKE_BLOCK(chunk2mem(remainder), remainder_size, SIZE_SZ,
 			      false);
     fREe_impl(chunk2mem(remainder)); /* let free() deal with it */
+    free_count--; /* not a free() by the caller */
   }
   else
   {
@@ -2022,6 +2175,7 @@ Void_t* mEMALIGn_impl(alignment, bytes) size_t alignment; size_t bytes;
     set_inuse_bit_at_offset(newp, newsize);
     set_head_size(p, leadsize);
     fREe_impl(chunk2mem(p));
+    free_count--; /* not a free() by the caller */
     p = newp;
     VALGRIND_MALLOCLIKE_BLOCK(chunk2mem(p), bytes, SIZE_SZ, false);
 
@@ -2040,6 +2194,7 @@ Void_t* mEMALIGn_impl(alignment, bytes) size_t alignment; size_t bytes;
     VALGRIND_MALLOCLIKE_BLOCK(chunk2mem(remainder), remainder_size, SIZE_SZ,
 			      false);
     fREe_impl(chunk2mem(remainder));
+    free_count--; /* not a free() by the caller */
   }
 
   check_inuse_chunk(p);
@@ -2388,6 +2543,9 @@ static void malloc_update_mallinfo(void)
     }
   }
 
+  /* Cached small chunks are free as far as callers are concerned */
+  avail += malloc_small_bytes();
+
   current_mallinfo.ordblks = navail;
   current_mallinfo.uordblks = sbrked_mem - avail;
   current_mallinfo.fordblks = avail;
@@ -2442,6 +2600,47 @@ struct mallinfo mALLINFo(void)
 }
 #endif	/* DEBUG */
 
+void malloc_get_info(struct malloc_info *info)
+{
+  mbinptr b;
+  mchunkptr p;
+  INTERNAL_SIZE_T sz;
+  int i;
+
+  memset(info, '\0', sizeof(*info));
+  info->malloc_count = malloc_count;
+  info->free_count = free_count;
+  info->small_hits = small_hits;
+  info->total_bytes = sbrked_mem;
+  if (sbrk_base != (char *)(-1))
+  {
+    sz = chunksize(top);
+    info->free_bytes = sz;
+    info->free_chunks = 1;
+    info->largest_free = sz;
+  }
+  for (i = 1; i < NAV; ++i)
+  {
+    b = bin_at(i);
+    for (p = last(b); p != b; p = p->bk)
+    {
+      sz = chunksize(p);
+      info->free_bytes += sz;
+      info->free_chunks++;
+      if (sz > info->largest_free)
+	info->largest_free = sz;
+    }
+  }
+
+#if CONFIG_IS_ENABLED(SYS_MALLOC_SMALL)
+  for (i = 0; i < SMALL_LISTS; i++)
+    info->small_chunks += small_count[i];
+#endif
+  info->small_bytes = malloc_small_bytes();
+  info->in_use_bytes = info->total_bytes - info->free_bytes -
+	info->small_bytes;
+}
+
 /*
   mallopt:
 
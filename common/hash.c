@@ -35,6 +35,10 @@
 #include <u-boot/sha512.h>
 #include <u-boot/md5.h>
 #include <u-boot/sm3.h>
+#if !defined(USE_HOSTCC) && CONFIG_IS_ENABLED(DM_HASH)
+#include <dm.h>
+#include <u-boot/hash.h>
+#endif
 
 static int __maybe_unused hash_init_sha1(struct hash_algo *algo, void **ctxp)
 {
@@ -380,6 +384,160 @@ static struct hash_algo hash_algo[] = {
 #define multi_hash()	0
 #endif
 
+#if !defined(USE_HOSTCC) && CONFIG_IS_ENABLED(DM_HASH)
+/**
+ * struct hash_dm_ctx - Context for progressive hashing which may use an engine
+ *
+ * @dev: Hash engine in use, or NULL to use @sw
+ * @sw: Software algorithm, used if no engine takes the hash
+ * @ctx: Context for @dev or @sw
+ */
+struct hash_dm_ctx {
+	struct udevice *dev;
+	struct hash_algo *sw;
+	void *ctx;
+};
+
+/*
+ * Entries returned by hash_progressive_lookup_algo() when an engine can do the
+ * work. This is in the data section as it may be set up before relocation.
+ */
+static struct hash_algo hash_dm_algo[ARRAY_SIZE(hash_algo)] __section(".data");
+
+static int hash_init_dm(struct hash_algo *algo, void **ctxp)
+{
+	enum HASH_ALGO id = hash_algo_lookup_by_name(algo->name);
+	struct hash_dm_ctx *ctx;
+	int ret;
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+	ret = hash_lookup_algo(algo->name, &ctx->sw);
+	if (ret)
+		goto err;
+
+	/* The size is not known, so treat it as large */
+	if (!hash_find_device(id, ULONG_MAX, &ctx->dev) &&
+	    !hash_init(ctx->dev, id, &ctx->ctx)) {
+		*ctxp = ctx;
+		return 0;
+	}
+
+	ctx->dev = NULL;
+	ret = ctx->sw->hash_init(ctx->sw, &ctx->ctx);
+	if (ret)
+		goto err;
+	*ctxp = ctx;
+
+	return 0;
+err:
+	free(ctx);
+
+	return ret;
+}
+
+static int hash_update_dm(struct hash_algo *algo, void *vctx, const void *buf,
+			  unsigned int size, int is_last)
+{
+	struct hash_dm_ctx *ctx = vctx;
+	int ret;
+
+	if (ctx->dev)
+		ret = hash_update(ctx->dev, ctx->ctx, buf, size);
+	else
+		ret = ctx->sw->hash_update(ctx->sw, ctx->ctx, buf, size,
+					   is_last);
+	if (ret) {
+		u8 digest[HASH_MAX_DIGEST_SIZE];
+
+		/* Finishing the hash lets the engine or algorithm free it */
+		if (ctx->dev)
+			hash_finish(ctx->dev, ctx->ctx, digest);
+		else
+			ctx->sw->hash_finish(ctx->sw, ctx->ctx, digest,
+					     sizeof(digest));
+		free(ctx);
+	}
+
+	return ret;
+}
+
+static int hash_finish_dm(struct hash_algo *algo, void *vctx, void *dest_buf,
+			  int size)
+{
+	struct hash_dm_ctx *ctx = vctx;
+	int ret;
+
+	if (!ctx->dev)
+		ret = ctx->sw->hash_finish(ctx->sw, ctx->ctx, dest_buf, size);
+	else if (size < algo->digest_size)
+		ret = -ENOSPC;
+	else
+		ret = hash_finish(ctx->dev, ctx->ctx, dest_buf);
+	free(ctx);
+
+	return ret;
+}
+
+/**
+ * hash_dm_progressive() - Get an algorithm which hashes with an engine
+ *
+ * @i: Index of the software algorithm in hash_algo[]
+ * Return: algorithm to use, or NULL if no engine supports it
+ */
+static struct hash_algo *hash_dm_progressive(int i)
+{
+	struct hash_algo *algo = &hash_dm_algo[i];
+	struct udevice *dev;
+
+	if (hash_find_device(hash_algo_lookup_by_name(hash_algo[i].name),
+			     ULONG_MAX, &dev))
+		return NULL;
+
+	*algo = hash_algo[i];
+	algo->hash_init = hash_init_dm;
+	algo->hash_update = hash_update_dm;
+	algo->hash_finish = hash_finish_dm;
+
+	return algo;
+}
+
+/**
+ * hash_dm_block() - Hash a block with an engine, if one is worth using
+ *
+ * @algo: Software algorithm
+ * @data: Data to hash
+ * @len: Length of data in bytes
+ * @output: Place to put the digest
+ * Return: 0 if done, -ve if the block must be hashed on the CPU
+ */
+static int hash_dm_block(struct hash_algo *algo, const void *data,
+			 unsigned int len, uint8_t *output)
+{
+	enum HASH_ALGO id = hash_algo_lookup_by_name(algo->name);
+	struct udevice *dev;
+	int ret;
+
+	ret = hash_find_device(id, len, &dev);
+	if (ret)
+		return ret;
+
+	return hash_digest_wd(dev, id, data, len, output, algo->chunk_size);
+}
+#else
+static inline struct hash_algo *hash_dm_progressive(int i)
+{
+	return NULL;
+}
+
+static inline int hash_dm_block(struct hash_algo *algo, const void *data,
+				unsigned int len, uint8_t *output)
+{
+	return -ENODEV;
+}
+#endif
+
 int hash_lookup_algo(const char *algo_name, struct hash_algo **algop)
 {
 	int i;
@@ -403,7 +561,9 @@ int hash_progressive_lookup_algo(const char *algo_name,
 	for (i = 0; i < ARRAY_SIZE(hash_algo); i++) {
 		if (!strcmp(algo_name, hash_algo[i].name)) {
 			if (hash_algo[i].hash_init) {
-				*algop = &hash_algo[i];
+				*algop = hash_dm_progressive(i);
+				if (!*algop)
+					*algop = &hash_algo[i];
 				return 0;
 			}
 		}
@@ -451,11 +611,95 @@ int hash_block(const char *algo_name, const void *data, unsigned int len,
 	}
 	if (output_size)
 		*output_size = algo->digest_size;
-	algo->hash_func_ws(data, len, output, algo->chunk_size);
+	if (hash_dm_block(algo, data, len, output))
+		algo->hash_func_ws(data, len, output, algo->chunk_size);
 
 	return 0;
 }
 
+int hash_stream_start(struct hash_stream *hs, const char *algo_name)
+{
+	int ret;
+
+	memset(hs, '\0', sizeof(*hs));
+	ret = hash_progressive_lookup_algo(algo_name, &hs->algo);
+	if (ret)
+		return ret;
+	if (hs->algo->digest_size > sizeof(hs->digest)) {
+		hs->algo = NULL;
+		return -EPROTONOSUPPORT;
+	}
+	if (hs->algo->hash_init(hs->algo, &hs->ctx)) {
+		hs->algo = NULL;
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+int hash_stream_update(struct hash_stream *hs, ulong offset, const void *buf,
+		       ulong size)
+{
+	ulong skip;
+
+	if (!hs || !hs->ctx)
+		return hs && hs->failed ? -EIO : 0;
+	if (offset > hs->size) {
+		log_debug("Gap in hashed data at %lx (expected %lx)\n", offset,
+			  hs->size);
+		hash_stream_abort(hs);
+		return -EIO;
+	}
+
+	/* Skip anything which was hashed already */
+	skip = hs->size - offset;
+	if (skip >= size)
+		return 0;
+	if (hs->algo->hash_update(hs->algo, hs->ctx, buf + skip, size - skip,
+				  0)) {
+		/* The context was freed by hash_update() */
+		hs->ctx = NULL;
+		hs->failed = true;
+		return -EIO;
+	}
+	hs->size += size - skip;
+
+	return 0;
+}
+
+int hash_stream_finish(struct hash_stream *hs)
+{
+	if (hs->failed)
+		return -EIO;
+	if (!hs->ctx)
+		return hs->done ? 0 : -ENOENT;
+	if (hs->algo->hash_finish(hs->algo, hs->ctx, hs->digest,
+				  sizeof(hs->digest))) {
+		hs->ctx = NULL;
+		hs->failed = true;
+		return -EIO;
+	}
+	hs->ctx = NULL;
+	hs->digest_size = hs->algo->digest_size;
+	hs->done = true;
+
+	return 0;
+}
+
+void hash_stream_abort(struct hash_stream *hs)
+{
+	u8 digest[HASH_MAX_DIGEST_SIZE];
+
+	if (!hs)
+		return;
+	if (hs->ctx)
+		hs->algo->hash_finish(hs->algo, hs->ctx, digest,
+				      sizeof(digest));
+	hs->ctx = NULL;
+	hs->done = false;
+	hs->failed = true;
+}
+
 #if !defined(CONFIG_XPL_BUILD) && (defined(CONFIG_CMD_HASH) || \
 	defined(CONFIG_CMD_SHA1SUM) || defined(CONFIG_CMD_CRC32)) || \
 	defined(CONFIG_CMD_MD5SUM)
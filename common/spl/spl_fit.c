@@ -193,6 +193,73 @@ static int get_aligned_image_size(struct spl_load_info *info, int data_size,
 	return ALIGN(data_size, spl_get_bl_len(info));
 }
 
+/**
+ * spl_fit_hash_start() - Start hashing an image while it is loaded
+ *
+ * This uses the first hash node whose algorithm supports progressive hashing.
+ * If there is none, @hs is left unstarted and the image is hashed after
+ * loading as usual.
+ *
+ * @fit: Pointer to the FIT
+ * @node: Offset of the image node
+ * @hs: Returns the hash stream
+ */
+static void spl_fit_hash_start(const void *fit, int node,
+			       struct hash_stream *hs)
+{
+	const char *algo;
+	int noffset;
+
+	memset(hs, '\0', sizeof(*hs));
+	fdt_for_each_subnode(noffset, fit, node) {
+		if (strncmp(fit_get_name(fit, noffset, NULL), FIT_HASH_NODENAME,
+			    strlen(FIT_HASH_NODENAME)))
+			continue;
+		if (!fit_image_hash_get_algo(fit, noffset, &algo) &&
+		    !hash_stream_start(hs, algo))
+			return;
+	}
+}
+
+/**
+ * spl_fit_read_hash() - Read image data, hashing it a piece at a time
+ *
+ * The data is read in pieces of CONFIG_SPL_FIT_HASH_STREAM_CHUNK bytes and
+ * each piece is hashed straight away, while it is still in the cache.
+ *
+ * @info: Information about the device to load from
+ * @offset: Offset to read from, aligned to the block length
+ * @size: Number of bytes to read, aligned to the block length
+ * @buf: Buffer to read into
+ * @overhead: Offset of the image data within @buf
+ * @length: Size of the image data
+ * @hs: Hash stream to update
+ * Return: number of bytes read
+ */
+static ulong spl_fit_read_hash(struct spl_load_info *info, ulong offset,
+			       ulong size, void *buf, ulong overhead,
+			       ulong length, struct hash_stream *hs)
+{
+	ulong chunk = ALIGN(CONFIG_IF_ENABLED_INT(FIT_HASH_STREAM,
+						  FIT_HASH_STREAM_CHUNK),
+			    spl_get_bl_len(info));
+	ulong pos, count, start, end;
+
+	for (pos = 0; pos < size; pos += count) {
+		count = info->read(info, offset + pos, min(chunk, size - pos),
+				   buf + pos);
+		start = max(pos, overhead);
+		end = min(pos + count, overhead + length);
+		if (end > start)
+			hash_stream_update(hs, start - overhead, buf + start,
+					   end - start);
+		if (count < min(chunk, size - pos))
+			return pos + count;
+	}
+
+	return pos;
+}
+
 /**
  * load_simple_fit(): load the image described in a certain FIT node
  * @info:	points to information about the device to load data from
@@ -221,6 +288,7 @@ static int load_simple_fit(struct spl_load_info *info, ulong fit_offset,
 	void *load_ptr;
 	void *src;
 	ulong overhead;
+	struct hash_stream hs, *hsp = NULL;
 	uint8_t image_comp = -1, type = -1;
 	const void *data;
 	const void *fit = ctx->fit;
@@ -305,8 +373,19 @@ static int load_simple_fit(struct spl_load_info *info, ulong fit_offset,
 		log_debug("reading from offset %x / %lx size %lx to %p: ",
 			  offset, read_offset, size, src_ptr);
 
-		if (info->read(info, read_offset, size, src_ptr) < length)
+		if (CONFIG_IS_ENABLED(FIT_HASH_STREAM)) {
+			hsp = &hs;
+			spl_fit_hash_start(fit, node, hsp);
+			if (spl_fit_read_hash(info, read_offset, size, src_ptr,
+					      overhead, length, hsp) < length) {
+				hash_stream_abort(hsp);
+				return -EIO;
+			}
+			hash_stream_finish(hsp);
+		} else if (info->read(info, read_offset, size, src_ptr) <
+			   length) {
 			return -EIO;
+		}
 
 		debug("External data: dst=%p, offset=%x, size=%lx\n",
 		      src_ptr, offset, (unsigned long)length);
@@ -325,8 +404,8 @@ static int load_simple_fit(struct spl_load_info *info, ulong fit_offset,
 	if (CONFIG_IS_ENABLED(FIT_SIGNATURE)) {
 		printf("## Checking hash(es) for Image %s ... ",
 		       fit_get_name(fit, node, NULL));
-		if (!fit_image_verify_with_data(fit, node, gd_fdt_blob(), src,
-						length))
+		if (!fit_image_verify_with_stream(fit, node, gd_fdt_blob(),
+						  src, length, hsp))
 			return -EPERM;
 		puts("OK\n");
 	}
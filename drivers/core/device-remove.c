@@ -15,6 +15,7 @@
 #include <malloc.h>
 #include <dm/device.h>
 #include <dm/device-internal.h>
+#include <dm/root.h>
 #include <dm/uclass.h>
 #include <dm/uclass-internal.h>
 #include <dm/util.h>
@@ -84,6 +85,9 @@ int device_unbind(struct udevice *dev)
 	drv = dev->driver;
 	assert(drv);
 
+	/* Its recorded child nodes can no longer be bound */
+	dm_lazy_drop(dev);
+
 	if (drv->unbind) {
 		ret = drv->unbind(dev);
 		if (ret)
@@ -98,15 +102,15 @@ int device_unbind(struct udevice *dev)
 	if (ret)
 		return log_msg_ret("uc", ret);
 	if (dev_get_flags(dev) & DM_FLAG_ALLOC_PDATA) {
-		free(dev_get_plat(dev));
+		dm_pool_free(dev_get_plat(dev));
 		dev_set_plat(dev, NULL);
 	}
 	if (dev_get_flags(dev) & DM_FLAG_ALLOC_UCLASS_PDATA) {
-		free(dev_get_uclass_plat(dev));
+		dm_pool_free(dev_get_uclass_plat(dev));
 		dev_set_uclass_plat(dev, NULL);
 	}
 	if (dev_get_flags(dev) & DM_FLAG_ALLOC_PARENT_PDATA) {
-		free(dev_get_parent_plat(dev));
+		dm_pool_free(dev_get_parent_plat(dev));
 		dev_set_parent_plat(dev, NULL);
 	}
 	ret = uclass_unbind_device(dev);
@@ -120,7 +124,7 @@ int device_unbind(struct udevice *dev)
 
 	if (dev_get_flags(dev) & DM_FLAG_NAME_ALLOCED)
 		free((char *)dev->name);
-	free(dev);
+	dm_pool_free(dev);
 
 	return 0;
 }
@@ -134,12 +138,12 @@ void device_free(struct udevice *dev)
 	int size;
 
 	if (dev->driver->priv_auto) {
-		free(dev_get_priv(dev));
+		dm_pool_free(dev_get_priv(dev));
 		dev_set_priv(dev, NULL);
 	}
 	size = dev->uclass->uc_drv->per_device_auto;
 	if (size) {
-		free(dev_get_uclass_priv(dev));
+		dm_pool_free(dev_get_uclass_priv(dev));
 		dev_set_uclass_priv(dev, NULL);
 	}
 	if (dev->parent) {
@@ -147,7 +151,7 @@ void device_free(struct udevice *dev)
 		if (!size)
 			size = dev->parent->uclass->uc_drv->per_child_auto;
 		if (size) {
-			free(dev_get_parent_priv(dev));
+			dm_pool_free(dev_get_parent_priv(dev));
 			dev_set_parent_priv(dev, NULL);
 		}
 	}
@@ -8,6 +8,7 @@
  * Pavel Herrmann <morpheus.ibis@gmail.com>
  */
 
+#include <bootstage.h>
 #include <cpu_func.h>
 #include <errno.h>
 #include <event.h>
@@ -26,6 +27,7 @@
 #include <dm/pinctrl.h>
 #include <dm/platdata.h>
 #include <dm/read.h>
+#include <dm/root.h>
 #include <dm/uclass.h>
 #include <dm/uclass-internal.h>
 #include <dm/util.h>
@@ -33,10 +35,20 @@
 #include <linux/err.h>
 #include <linux/list.h>
 #include <power-domain.h>
+#include <uthread.h>
 #include <linux/printk.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
+#if CONFIG_IS_ENABLED(DM_TIMING)
+#define device_timing_start()	timer_get_boot_us()
+#define device_timing_end(dev, field, start) \
+	((dev)->timing.field += timer_get_boot_us() - (start))
+#else
+#define device_timing_start()	0UL
+#define device_timing_end(dev, field, start)	((void)(start))
+#endif
+
 static int device_bind_common(struct udevice *parent, const struct driver *drv,
 			      const char *name, void *plat,
 			      ulong driver_data, ofnode node,
@@ -46,6 +58,7 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 	struct uclass *uc;
 	int size, ret = 0;
 	bool auto_seq = true;
+	ulong start;
 	void *ptr;
 
 	if (CONFIG_IS_ENABLED(OF_PLATDATA_NO_BIND))
@@ -56,13 +69,14 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 	if (!name)
 		return -EINVAL;
 
-	ret = uclass_get(drv->id, &uc);
+	start = device_timing_start();
+	ret = uclass_get_nolazy(drv->id, &uc);
 	if (ret) {
 		dm_warn("Missing uclass for driver %s\n", drv->name);
 		return ret;
 	}
 
-	dev = calloc(1, sizeof(struct udevice));
+	dev = dm_pool_alloc(sizeof(struct udevice));
 	if (!dev)
 		return -ENOMEM;
 
@@ -116,7 +130,7 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 		}
 		if (alloc) {
 			dev_or_flags(dev, DM_FLAG_ALLOC_PDATA);
-			ptr = calloc(1, drv->plat_auto);
+			ptr = dm_pool_alloc(drv->plat_auto);
 			if (!ptr) {
 				ret = -ENOMEM;
 				goto fail_alloc1;
@@ -135,7 +149,7 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 	size = uc->uc_drv->per_device_plat_auto;
 	if (size) {
 		dev_or_flags(dev, DM_FLAG_ALLOC_UCLASS_PDATA);
-		ptr = calloc(1, size);
+		ptr = dm_pool_alloc(size);
 		if (!ptr) {
 			ret = -ENOMEM;
 			goto fail_alloc2;
@@ -149,7 +163,7 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 			size = parent->uclass->uc_drv->per_child_plat_auto;
 		if (size) {
 			dev_or_flags(dev, DM_FLAG_ALLOC_PARENT_PDATA);
-			ptr = calloc(1, size);
+			ptr = dm_pool_alloc(size);
 			if (!ptr) {
 				ret = -ENOMEM;
 				goto fail_alloc3;
@@ -187,6 +201,7 @@ static int device_bind_common(struct udevice *parent, const struct driver *drv,
 		*devp = dev;
 
 	dev_or_flags(dev, DM_FLAG_BOUND);
+	device_timing_end(dev, bind_us, start);
 
 	return 0;
 
@@ -211,28 +226,28 @@ fail_uclass_bind:
 	if (CONFIG_IS_ENABLED(DM_DEVICE_REMOVE)) {
 		list_del(&dev->sibling_node);
 		if (dev_get_flags(dev) & DM_FLAG_ALLOC_PARENT_PDATA) {
-			free(dev_get_parent_plat(dev));
+			dm_pool_free(dev_get_parent_plat(dev));
 			dev_set_parent_plat(dev, NULL);
 		}
 	}
 fail_alloc3:
 	if (CONFIG_IS_ENABLED(DM_DEVICE_REMOVE)) {
 		if (dev_get_flags(dev) & DM_FLAG_ALLOC_UCLASS_PDATA) {
-			free(dev_get_uclass_plat(dev));
+			dm_pool_free(dev_get_uclass_plat(dev));
 			dev_set_uclass_plat(dev, NULL);
 		}
 	}
 fail_alloc2:
 	if (CONFIG_IS_ENABLED(DM_DEVICE_REMOVE)) {
 		if (dev_get_flags(dev) & DM_FLAG_ALLOC_PDATA) {
-			free(dev_get_plat(dev));
+			dm_pool_free(dev_get_plat(dev));
 			dev_set_plat(dev, NULL);
 		}
 	}
 fail_alloc1:
 	devres_release_all(dev);
 
-	free(dev);
+	dm_pool_free(dev);
 
 	return ret;
 }
@@ -332,7 +347,7 @@ static void *alloc_priv(int size, uint flags)
 			flush_dcache_range((ulong)priv, (ulong)priv + size);
 		}
 	} else {
-		priv = calloc(1, size);
+		priv = dm_pool_alloc(size);
 	}
 
 	return priv;
@@ -389,6 +404,7 @@ static int device_alloc_priv(struct udevice *dev)
 int device_of_to_plat(struct udevice *dev)
 {
 	const struct driver *drv;
+	ulong start;
 	int ret;
 
 	if (!dev)
@@ -427,7 +443,9 @@ int device_of_to_plat(struct udevice *dev)
 
 	if (drv->of_to_plat &&
 	    (CONFIG_IS_ENABLED(OF_PLATDATA) || dev_has_ofnode(dev))) {
+		start = device_timing_start();
 		ret = drv->of_to_plat(dev);
+		device_timing_end(dev, of_to_plat_us, start);
 		if (ret)
 			goto fail;
 	}
@@ -478,15 +496,151 @@ static int device_get_dma_constraints(struct udevice *dev)
 	return 0;
 }
 
+#if CONFIG_IS_ENABLED(DM_PROBE_THREADS)
+/**
+ * struct device_probe_wait - A thread waiting for a device to be probed
+ *
+ * @thread: Thread which is waiting
+ * @dev: Device it is waiting for, being probed by another thread
+ * @next: Next waiting thread, or NULL
+ */
+struct device_probe_wait {
+	struct uthread *thread;
+	struct udevice *dev;
+	struct device_probe_wait *next;
+};
+
+/*
+ * Threads waiting in device_is_probed(), each entry is on its thread's stack.
+ * Threads only run after relocation, so this is never used before then.
+ */
+static struct device_probe_wait *probe_waits;
+
+static void device_set_probe_thread(struct udevice *dev, struct uthread *thr)
+{
+	dev->probe_thread = thr;
+}
+
+static bool device_probing_elsewhere(const struct udevice *dev)
+{
+	return dev->probe_thread && dev->probe_thread != uthread_self();
+}
+
+/**
+ * device_probe_would_deadlock() - Check if waiting for a device would deadlock
+ *
+ * Follows the chain of threads from the one probing @dev, to the device that
+ * thread is waiting for, and so on. If the chain comes back to the current
+ * thread, the devices depend on each other (e.g. two suppliers which each
+ * need the other) and waiting would never end.
+ *
+ * @dev: Device being probed by another thread
+ * Return: true if the thread probing @dev is waiting, directly or indirectly,
+ * for the current thread
+ */
+static bool device_probe_would_deadlock(const struct udevice *dev)
+{
+	struct uthread *self = uthread_self();
+	struct device_probe_wait *wait;
+
+	while (dev->probe_thread) {
+		if (dev->probe_thread == self)
+			return true;
+		for (wait = probe_waits; wait; wait = wait->next) {
+			if (wait->thread == dev->probe_thread)
+				break;
+		}
+		if (!wait)
+			return false;
+		dev = wait->dev;
+	}
+
+	return false;
+}
+
+static void device_wait_probe(struct udevice *dev)
+{
+	struct device_probe_wait wait, **waitp;
+
+	wait.thread = uthread_self();
+	wait.dev = dev;
+	wait.next = probe_waits;
+	probe_waits = &wait;
+
+	uthread_schedule();
+
+	for (waitp = &probe_waits; *waitp != &wait; waitp = &(*waitp)->next)
+		;
+	*waitp = wait.next;
+}
+
+bool device_active(const struct udevice *dev)
+{
+	return (dev_get_flags(dev) & DM_FLAG_ACTIVATED) &&
+	       !device_probing_elsewhere(dev);
+}
+#else
+static inline void device_set_probe_thread(struct udevice *dev,
+					   struct uthread *thr)
+{
+}
+
+static inline bool device_probing_elsewhere(const struct udevice *dev)
+{
+	return false;
+}
+
+static inline bool device_probe_would_deadlock(const struct udevice *dev)
+{
+	return false;
+}
+
+static inline void device_wait_probe(struct udevice *dev)
+{
+}
+#endif
+
+/**
+ * device_is_probed() - Check whether a device is already probed
+ *
+ * If another thread is part-way through probing the device, this waits for it
+ * to finish, so that the caller never sees a half-probed device. The thread
+ * doing the probe sees the device as probed, as before, so that drivers can
+ * probe their children from their probe() method.
+ *
+ * If the other thread is itself waiting for a device which this thread is
+ * probing, the device is treated as probed instead, as it would be if both
+ * were probed in the same thread. Otherwise neither thread could finish.
+ *
+ * @dev: Device to check
+ * Return: true if the device is active, false if it must be probed
+ */
+static bool device_is_probed(struct udevice *dev)
+{
+	while (dev_get_flags(dev) & DM_FLAG_ACTIVATED) {
+		if (!device_probing_elsewhere(dev))
+			return true;
+		if (device_probe_would_deadlock(dev)) {
+			log_debug("%s: circular dependency while probing\n",
+				  dev->name);
+			return true;
+		}
+		device_wait_probe(dev);
+	}
+
+	return false;
+}
+
 int device_probe(struct udevice *dev)
 {
 	const struct driver *drv;
+	ulong start;
 	int ret;
 
 	if (!dev)
 		return -EINVAL;
 
-	if (dev_get_flags(dev) & DM_FLAG_ACTIVATED)
+	if (device_is_probed(dev))
 		return 0;
 
 	ret = device_notify(dev, EVT_DM_PRE_PROBE);
@@ -512,11 +666,13 @@ int device_probe(struct udevice *dev)
 		 * (e.g. PCI bridge devices). Test the flags again
 		 * so that we don't mess up the device.
 		 */
-		if (dev_get_flags(dev) & DM_FLAG_ACTIVATED)
+		if (device_is_probed(dev))
 			return 0;
 	}
 
 	dev_or_flags(dev, DM_FLAG_ACTIVATED);
+	device_set_probe_thread(dev, uthread_self());
+	start = device_timing_start();
 
 	if (CONFIG_IS_ENABLED(POWER_DOMAIN) && dev->parent &&
 	    (device_get_uclass_id(dev) != UCLASS_POWER_DOMAIN) &&
@@ -579,14 +735,19 @@ int device_probe(struct udevice *dev)
 		if (ret)
 			goto fail;
 	}
+	device_timing_end(dev, pre_probe_us, start);
 
 	if (drv->probe) {
+		start = device_timing_start();
 		ret = drv->probe(dev);
+		device_timing_end(dev, probe_us, start);
 		if (ret)
 			goto fail;
 	}
 
+	start = device_timing_start();
 	ret = uclass_post_probe_device(dev);
+	device_timing_end(dev, post_probe_us, start);
 	if (ret)
 		goto fail_uclass;
 
@@ -600,6 +761,7 @@ int device_probe(struct udevice *dev)
 	ret = device_notify(dev, EVT_DM_POST_PROBE);
 	if (ret)
 		goto fail_event;
+	device_set_probe_thread(dev, NULL);
 
 	return 0;
 fail_event:
@@ -610,6 +772,7 @@ fail_uclass:
 	}
 fail:
 	dev_bic_flags(dev, DM_FLAG_ACTIVATED);
+	device_set_probe_thread(dev, NULL);
 
 	device_free(dev);
 
@@ -791,6 +954,7 @@ int device_get_child(const struct udevice *parent, int index,
 {
 	struct udevice *dev;
 
+	dm_lazy_bind_children(parent);
 	device_foreach_child(dev, parent) {
 		if (!index--)
 			return device_get_device_tail(dev, 0, devp);
@@ -804,6 +968,7 @@ int device_get_child_count(const struct udevice *parent)
 	struct udevice *dev;
 	int count = 0;
 
+	dm_lazy_bind_children(parent);
 	device_foreach_child(dev, parent)
 		count++;
 
@@ -827,6 +992,7 @@ int device_find_child_by_seq(const struct udevice *parent, int seq,
 	struct udevice *dev;
 
 	*devp = NULL;
+	dm_lazy_bind_children(parent);
 
 	device_foreach_child(dev, parent) {
 		if (dev->seq_ == seq) {
@@ -856,6 +1022,7 @@ int device_find_child_by_of_offset(const struct udevice *parent, int of_offset,
 	struct udevice *dev;
 
 	*devp = NULL;
+	dm_lazy_bind_children(parent);
 
 	device_foreach_child(dev, parent) {
 		if (dev_of_offset(dev) == of_offset) {
@@ -898,6 +1065,8 @@ static struct udevice *_device_find_global_by_ofnode(struct udevice *parent,
 int device_find_global_by_ofnode(ofnode ofnode, struct udevice **devp)
 {
 	*devp = _device_find_global_by_ofnode(gd->dm_root, ofnode);
+	if (!*devp && dm_lazy_bind_ofnode(ofnode) > 0)
+		*devp = _device_find_global_by_ofnode(gd->dm_root, ofnode);
 
 	return *devp ? 0 : -ENOENT;
 }
@@ -907,6 +1076,8 @@ int device_get_global_by_ofnode(ofnode ofnode, struct udevice **devp)
 	struct udevice *dev;
 
 	dev = _device_find_global_by_ofnode(gd->dm_root, ofnode);
+	if (!dev && dm_lazy_bind_ofnode(ofnode) > 0)
+		dev = _device_find_global_by_ofnode(gd->dm_root, ofnode);
 	return device_get_device_tail(dev, dev ? 0 : -ENOENT, devp);
 }
 
@@ -932,6 +1103,7 @@ int device_get_by_ofplat_idx(uint idx, struct udevice **devp)
 
 int device_find_first_child(const struct udevice *parent, struct udevice **devp)
 {
+	dm_lazy_bind_children(parent);
 	if (list_empty(&parent->child_head)) {
 		*devp = NULL;
 	} else {
@@ -964,6 +1136,7 @@ int device_find_first_inactive_child(const struct udevice *parent,
 	struct udevice *dev;
 
 	*devp = NULL;
+	dm_lazy_bind_children(parent);
 	device_foreach_child(dev, parent) {
 		if (!device_active(dev) &&
 		    device_get_uclass_id(dev) == uclass_id) {
@@ -982,6 +1155,7 @@ int device_find_first_child_by_uclass(const struct udevice *parent,
 	struct udevice *dev;
 
 	*devp = NULL;
+	dm_lazy_bind_children(parent);
 	device_foreach_child(dev, parent) {
 		if (device_get_uclass_id(dev) == uclass_id) {
 			*devp = dev;
@@ -998,6 +1172,7 @@ int device_find_child_by_namelen(const struct udevice *parent, const char *name,
 	struct udevice *dev;
 
 	*devp = NULL;
+	dm_lazy_bind_children(parent);
 
 	device_foreach_child(dev, parent) {
 		if (!strncmp(dev->name, name, len) &&
@@ -1107,6 +1282,7 @@ const char *dev_get_uclass_name(const struct udevice *dev)
 
 bool device_has_children(const struct udevice *dev)
 {
+	dm_lazy_bind_children(dev);
 	return !list_empty(&dev->child_head);
 }
 
@@ -1114,9 +1290,8 @@ bool device_has_active_children(const struct udevice *dev)
 {
 	struct udevice *child;
 
-	for (device_find_first_child(dev, &child);
-	     child;
-	     device_find_next_child(&child)) {
+	/* Recorded nodes are never active, so there is no need to bind them */
+	device_foreach_child(child, dev) {
 		if (device_active(child))
 			return true;
 	}
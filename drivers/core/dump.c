@@ -31,7 +31,7 @@ static int h_cmp_uclass_id(const void *d1, const void *d2)
 }
 
 static void show_devices(struct udevice *dev, int depth, int last_flag,
-			 struct udevice **devs)
+			 struct udevice **devs, bool timing)
 {
 	int i, is_last;
 	struct udevice *child;
@@ -42,6 +42,8 @@ static void show_devices(struct udevice *dev, int depth, int last_flag,
 	       " %-10.10s  %3d  [ %c ]   %-20.20s  ", dev->uclass->uc_drv->name,
 	       dev->seq_,
 	       flags & DM_FLAG_ACTIVATED ? '+' : ' ', dev->driver->name);
+	if (CONFIG_IS_ENABLED(DM_TIMING) && timing)
+		printf("%9lu %8lu  ", dev_get_time_us(dev), dev_get_mem(dev));
 
 	for (i = depth; i >= 0; i--) {
 		is_last = (last_flag >> i) & 1;
@@ -72,19 +74,19 @@ static void show_devices(struct udevice *dev, int depth, int last_flag,
 		for (i = 0; i < count; i++) {
 			show_devices(devs[i], depth + 1,
 				     (last_flag << 1) | (i == count - 1),
-				     devs + count);
+				     devs + count, timing);
 		}
 	} else {
 		device_foreach_child(child, dev) {
 			is_last = list_is_last(&child->sibling_node,
 					       &dev->child_head);
 			show_devices(child, depth + 1,
-				     (last_flag << 1) | is_last, NULL);
+				     (last_flag << 1) | is_last, NULL, timing);
 		}
 	}
 }
 
-static void dm_dump_tree_single(struct udevice *dev, bool sort)
+static void dm_dump_tree_single(struct udevice *dev, bool sort, bool timing)
 {
 	int dev_count, uclasses;
 	struct udevice **devs = NULL;
@@ -97,12 +99,12 @@ static void dm_dump_tree_single(struct udevice *dev, bool sort)
 			return;
 		}
 	}
-	show_devices(dev, -1, 0, devs);
+	show_devices(dev, -1, 0, devs, timing);
 	free(devs);
 }
 
 static void dm_dump_tree_recursive(struct udevice *dev, char *dev_name,
-				   bool extended, bool sort)
+				   bool extended, bool sort, bool timing)
 {
 	struct udevice *child;
 	size_t len;
@@ -112,36 +114,68 @@ static void dm_dump_tree_recursive(struct udevice *dev, char *dev_name,
 	device_foreach_child(child, dev) {
 		if (extended) {
 			if (!strncmp(child->name, dev_name, len)) {
-				dm_dump_tree_single(child, sort);
+				dm_dump_tree_single(child, sort, timing);
 				continue;
 			}
 		} else {
 			if (!strcmp(child->name, dev_name)) {
-				dm_dump_tree_single(child, sort);
+				dm_dump_tree_single(child, sort, timing);
 				continue;
 			}
 		}
-		dm_dump_tree_recursive(child, dev_name, extended, sort);
+		dm_dump_tree_recursive(child, dev_name, extended, sort, timing);
 	}
 }
 
-void dm_dump_tree(char *dev_name, bool extended, bool sort)
+/**
+ * dm_dump_driver_timing() - Show the drivers which took the most time
+ *
+ * @max: Maximum number of drivers to show
+ */
+static void dm_dump_driver_timing(int max)
+{
+	struct dm_driver_timing *list;
+	int count, i;
+
+	count = dm_get_driver_timing(&list);
+	if (count < 0) {
+		printf("(out of memory)\n");
+		return;
+	}
+
+	printf("\nSlowest drivers:\n");
+	printf(" Time(us)  Devices       Mem  Driver\n");
+	for (i = 0; i < count && i < max; i++) {
+		printf("%9lu %8d %9lu  %s\n", list[i].time_us,
+		       list[i].dev_count, list[i].mem, list[i].drv->name);
+	}
+	free(list);
+}
+
+void dm_dump_tree(char *dev_name, bool extended, bool sort, bool timing)
 {
 	struct udevice *root;
 
-	printf(" Class     Seq    Probed  Driver                Name\n");
-	printf("-----------------------------------------------------------\n");
+	timing = CONFIG_IS_ENABLED(DM_TIMING) && timing;
+	if (timing) {
+		printf(" Class     Seq    Probed  Driver                 Time(us)      Mem  Name\n");
+		printf("-----------------------------------------------------------------------------\n");
+	} else {
+		printf(" Class     Seq    Probed  Driver                Name\n");
+		printf("-----------------------------------------------------------\n");
+	}
 
 	root = dm_root();
 	if (!root)
 		return;
 
-	if (!dev_name || !strcmp(dev_name, "root")) {
-		dm_dump_tree_single(root, sort);
-		return;
-	}
+	if (!dev_name || !strcmp(dev_name, "root"))
+		dm_dump_tree_single(root, sort, timing);
+	else
+		dm_dump_tree_recursive(root, dev_name, extended, sort, timing);
 
-	dm_dump_tree_recursive(root, dev_name, extended, sort);
+	if (timing)
+		dm_dump_driver_timing(10);
 }
 
 /**
@@ -336,6 +370,21 @@ void dm_dump_mem(struct dm_stats *stats)
 	printf("Total size: %x (%d)\n", stats->total_size, stats->total_size);
 	printf("\n");
 
+	if (CONFIG_IS_ENABLED(DM_POOL)) {
+		printf("%-6s  %5s  %5s  %5s  %6s\n", "Pool", "Slabs", "Total",
+		       "Used", "Bytes");
+		printf("%-6s  %5s  %5s  %5s  %6s\n", "------", "-----", "-----",
+		       "-----", "------");
+		for (i = 0; i < DM_POOL_COUNT; i++) {
+			const struct dm_pool_stats *pool = &stats->pool[i];
+
+			printf("%6x  %5x  %5x  %5x  %6x\n", pool->size,
+			       pool->slab_count, pool->total, pool->used,
+			       pool->total * pool->size);
+		}
+		printf("\n");
+	}
+
 	total = stats->total_size;
 	total -= total_delta;
 	printf("With tags:       %x (%d)\n", total, total);
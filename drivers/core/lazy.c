@@ -0,0 +1,309 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Deferred binding of devicetree nodes
+ *
+ * Nodes which are not needed immediately are recorded when the devicetree is
+ * scanned, along with the uclasses which they, or their subnodes, may provide.
+ * They are bound when one of those uclasses is looked up.
+ */
+
+#define LOG_CATEGORY LOGC_DM
+
+#include <dm.h>
+#include <log.h>
+#include <malloc.h>
+#include <asm/global_data.h>
+#include <dm/lists.h>
+#include <dm/root.h>
+#include <dm/uclass.h>
+#include <linux/bitops.h>
+#include <linux/list.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+#define DM_LAZY_LONGS	BITS_TO_LONGS(UCLASS_COUNT)
+
+/**
+ * struct dm_lazy_node - A devicetree node which has not been bound yet
+ *
+ * @sibling_node: Node in the list of recorded nodes
+ * @parent: Device to bind the node to
+ * @node: Devicetree node
+ * @uclasses: Bitmap of uclass IDs which this node or its subnodes may provide
+ */
+struct dm_lazy_node {
+	struct list_head sibling_node;
+	struct udevice *parent;
+	ofnode node;
+	ulong uclasses[DM_LAZY_LONGS];
+};
+
+/**
+ * struct dm_lazy - Information about deferred binding
+ *
+ * @head: List of struct dm_lazy_node, in devicetree order
+ * @pending: Bitmap of uclass IDs which have recorded nodes
+ * @eager: Bitmap of uclass IDs to bind immediately, from
+ *	CONFIG_DM_LAZY_BIND_UCLASSES
+ */
+struct dm_lazy {
+	struct list_head head;
+	ulong pending[DM_LAZY_LONGS];
+	ulong eager[DM_LAZY_LONGS];
+};
+
+static bool lazy_test(const ulong *map, enum uclass_id id)
+{
+	return map[BIT_WORD(id)] & BIT_MASK(id);
+}
+
+int dm_lazy_init(void)
+{
+	const char *names = CONFIG_DM_LAZY_BIND_UCLASSES;
+	struct dm_lazy *lazy;
+
+	if (gd_dm_lazy())
+		return 0;
+	lazy = calloc(1, sizeof(*lazy));
+	if (!lazy)
+		return log_msg_ret("lazy", -ENOMEM);
+	INIT_LIST_HEAD(&lazy->head);
+
+	while (*names) {
+		enum uclass_id id;
+		int len;
+
+		len = strcspn(names, " ");
+		if (len) {
+			id = uclass_get_by_namelen(names, len);
+			if (id != UCLASS_INVALID)
+				lazy->eager[BIT_WORD(id)] |= BIT_MASK(id);
+			else
+				log_debug("Unknown uclass '%.*s'\n", len, names);
+		}
+		names += len;
+		if (*names)
+			names++;
+	}
+	gd_set_dm_lazy(lazy);
+
+	return 0;
+}
+
+void dm_lazy_uninit(void)
+{
+	struct dm_lazy *lazy = gd_dm_lazy();
+	struct dm_lazy_node *entry, *next;
+
+	if (!lazy)
+		return;
+	list_for_each_entry_safe(entry, next, &lazy->head, sibling_node)
+		free(entry);
+	free(lazy);
+	gd_set_dm_lazy(NULL);
+}
+
+/**
+ * lazy_add_uclasses() - Add the uclasses which a node may provide
+ *
+ * This checks the first matching driver for each compatible string of @node,
+ * then does the same for its enabled subnodes.
+ *
+ * @node: Node to check
+ * @map: Bitmap to update
+ */
+static void lazy_add_uclasses(ofnode node, ulong *map)
+{
+	const char *compat_list, *compat;
+	struct driver *drv;
+	ofnode subnode;
+	int len, i;
+
+	compat_list = ofnode_get_property(node, "compatible", &len);
+	for (i = 0; compat_list && i < len; i += strlen(compat) + 1) {
+		compat = compat_list + i;
+		drv = lists_driver_lookup_compat(compat);
+		if (drv && drv->id >= 0 && drv->id < UCLASS_COUNT)
+			map[BIT_WORD(drv->id)] |= BIT_MASK(drv->id);
+	}
+
+	ofnode_for_each_subnode(subnode, node) {
+		if (ofnode_is_enabled(subnode))
+			lazy_add_uclasses(subnode, map);
+	}
+}
+
+bool dm_lazy_defer(struct udevice *parent, ofnode node, bool pre_reloc_only)
+{
+	struct dm_lazy *lazy = gd_dm_lazy();
+	ulong map[DM_LAZY_LONGS] = {};
+	struct dm_lazy_node *entry;
+	bool found = false;
+	int i;
+
+	if (!lazy || pre_reloc_only || ofnode_pre_reloc(node))
+		return false;
+
+	lazy_add_uclasses(node, map);
+	for (i = 0; i < DM_LAZY_LONGS; i++) {
+		if (map[i] & lazy->eager[i])
+			return false;
+		if (map[i])
+			found = true;
+	}
+	if (!found)
+		return false;
+
+	entry = malloc(sizeof(*entry));
+	if (!entry)
+		return false;
+	entry->parent = parent;
+	entry->node = node;
+	memcpy(entry->uclasses, map, sizeof(map));
+	list_add_tail(&entry->sibling_node, &lazy->head);
+	for (i = 0; i < DM_LAZY_LONGS; i++)
+		lazy->pending[i] |= map[i];
+	log_debug("Deferring '%s'\n", ofnode_get_name(node));
+
+	return true;
+}
+
+/**
+ * lazy_bind() - Bind a recorded node and forget it
+ *
+ * @entry: Node to bind, which is freed
+ * Return: 0 if OK, -ve on error
+ */
+static int lazy_bind(struct dm_lazy_node *entry)
+{
+	struct udevice *parent = entry->parent;
+	ofnode node = entry->node;
+
+	list_del(&entry->sibling_node);
+	free(entry);
+	log_debug("Binding deferred '%s'\n", ofnode_get_name(node));
+
+	return lists_bind_fdt(parent, node, NULL, NULL, false);
+}
+
+int dm_lazy_bind_uclass(enum uclass_id id)
+{
+	struct dm_lazy *lazy = gd_dm_lazy();
+	struct dm_lazy_node *entry;
+	int ret, err = 0;
+
+	if (!lazy || id < 0 || id >= UCLASS_COUNT ||
+	    !lazy_test(lazy->pending, id))
+		return 0;
+
+	/*
+	 * Binding may look up other uclasses, or record subnodes, so start
+	 * again from the top of the list each time
+	 */
+	lazy->pending[BIT_WORD(id)] &= ~BIT_MASK(id);
+again:
+	list_for_each_entry(entry, &lazy->head, sibling_node) {
+		if (lazy_test(entry->uclasses, id)) {
+			ret = lazy_bind(entry);
+			if (ret && !err)
+				err = ret;
+			goto again;
+		}
+	}
+	lazy->pending[BIT_WORD(id)] &= ~BIT_MASK(id);
+
+	return err;
+}
+
+int dm_lazy_bind_ofnode(ofnode node)
+{
+	struct dm_lazy *lazy = gd_dm_lazy();
+	struct dm_lazy_node *entry;
+	int count = 0;
+	ofnode np;
+	int ret;
+
+	if (!lazy)
+		return 0;
+
+	/*
+	 * Binding a parent may record its subnodes, or bind them from its
+	 * bind() method, so start again from @node each time
+	 */
+again:
+	for (np = node; ofnode_valid(np); np = ofnode_get_parent(np)) {
+		list_for_each_entry(entry, &lazy->head, sibling_node) {
+			if (ofnode_equal(entry->node, np)) {
+				ret = lazy_bind(entry);
+				if (ret)
+					return ret;
+				count++;
+				goto again;
+			}
+		}
+	}
+
+	return count;
+}
+
+int dm_lazy_bind_children(const struct udevice *parent)
+{
+	struct dm_lazy *lazy = gd_dm_lazy();
+	struct dm_lazy_node *entry;
+	int count = 0;
+	int ret, err = 0;
+
+	if (!lazy)
+		return 0;
+
+	/* Binding may record or bind other nodes, so start again each time */
+again:
+	list_for_each_entry(entry, &lazy->head, sibling_node) {
+		if (entry->parent == parent) {
+			ret = lazy_bind(entry);
+			if (ret && !err)
+				err = ret;
+			count++;
+			goto again;
+		}
+	}
+
+	return err ? err : count;
+}
+
+int dm_lazy_bind_all(void)
+{
+	struct dm_lazy *lazy = gd_dm_lazy();
+	struct dm_lazy_node *entry;
+	int count = 0;
+	int ret, err = 0;
+
+	if (!lazy)
+		return 0;
+	while (!list_empty(&lazy->head)) {
+		entry = list_first_entry(&lazy->head, struct dm_lazy_node,
+					 sibling_node);
+		ret = lazy_bind(entry);
+		if (ret && !err)
+			err = ret;
+		count++;
+	}
+	memset(lazy->pending, '\0', sizeof(lazy->pending));
+
+	return err ? err : count;
+}
+
+void dm_lazy_drop(struct udevice *parent)
+{
+	struct dm_lazy *lazy = gd_dm_lazy();
+	struct dm_lazy_node *entry, *next;
+
+	if (!lazy)
+		return;
+	list_for_each_entry_safe(entry, next, &lazy->head, sibling_node) {
+		if (entry->parent == parent) {
+			list_del(&entry->sibling_node);
+			free(entry);
+		}
+	}
+}
@@ -11,6 +11,9 @@
 #include <debug_uart.h>
 #include <errno.h>
 #include <log.h>
+#include <malloc.h>
+#include <sort.h>
+#include <asm/global_data.h>
 #include <dm/device.h>
 #include <dm/device-internal.h>
 #include <dm/lists.h>
@@ -20,6 +23,8 @@
 #include <fdtdec.h>
 #include <linux/compiler.h>
 
+DECLARE_GLOBAL_DATA_PTR;
+
 struct driver *lists_driver_lookup_name(const char *name)
 {
 	struct driver *drv =
@@ -196,6 +201,116 @@ static int driver_check_compatible(const struct udevice_id *of_match,
 	return -ENOENT;
 }
 
+static int compat_entry_cmp(const void *a, const void *b)
+{
+	const struct lists_compat_entry *ea = a, *eb = b;
+	int ret;
+
+	ret = strcmp(ea->id->compatible, eb->id->compatible);
+	if (ret)
+		return ret;
+
+	/* Keep linker-list order so the first matching driver wins */
+	if (ea->drv != eb->drv)
+		return ea->drv < eb->drv ? -1 : 1;
+
+	return ea->id < eb->id ? -1 : ea->id > eb->id;
+}
+
+int lists_compat_index_init(void)
+{
+	struct driver *driver = ll_entry_start(struct driver, driver);
+	const int n_ents = ll_entry_count(struct driver, driver);
+	struct lists_compat_entry *idx;
+	const struct udevice_id *id;
+	struct driver *entry;
+	int count = 0;
+
+	for (entry = driver; entry != driver + n_ents; entry++) {
+		for (id = entry->of_match; id && id->compatible; id++)
+			count++;
+	}
+
+	idx = malloc(max(count, 1) * sizeof(*idx));
+	if (!idx)
+		return log_msg_ret("idx", -ENOMEM);
+
+	count = 0;
+	for (entry = driver; entry != driver + n_ents; entry++) {
+		for (id = entry->of_match; id && id->compatible; id++) {
+			idx[count].id = id;
+			idx[count].drv = entry;
+			count++;
+		}
+	}
+	qsort(idx, count, sizeof(*idx), compat_entry_cmp);
+	gd_set_dm_compat_index(idx, count);
+	log_debug("Indexed %d compatible strings\n", count);
+
+	return 0;
+}
+
+/**
+ * lists_compat_find() - Find the first driver which has a compatible string
+ *
+ * @compat: Compatible string to look up
+ * @drvp: Returns the driver found
+ * @idp: Returns the matching entry in the driver's of_match table
+ * Return: 0 if found, -ENOENT if no driver has @compat, -ENOSYS if there is
+ * no index
+ */
+static int lists_compat_find(const char *compat, struct driver **drvp,
+			     const struct udevice_id **idp)
+{
+	struct lists_compat_entry *idx = gd_dm_compat_index();
+	int count = gd_dm_compat_count();
+	int lo, hi;
+
+	if (!idx)
+		return -ENOSYS;
+
+	lo = 0;
+	hi = count;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+
+		if (strcmp(idx[mid].id->compatible, compat) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == count || strcmp(idx[lo].id->compatible, compat))
+		return -ENOENT;
+	*drvp = idx[lo].drv;
+	*idp = idx[lo].id;
+
+	return 0;
+}
+
+struct driver *lists_driver_lookup_compat(const char *compat)
+{
+	struct driver *driver = ll_entry_start(struct driver, driver);
+	const int n_ents = ll_entry_count(struct driver, driver);
+	const struct udevice_id *id;
+	struct driver *entry;
+	int ret;
+
+	ret = -ENOSYS;
+	if (CONFIG_IS_ENABLED(DM_COMPAT_INDEX))
+		ret = lists_compat_find(compat, &entry, &id);
+	if (ret == -ENOENT)
+		return NULL;
+	if (!ret)
+		return entry;
+
+	for (entry = driver; entry != driver + n_ents; entry++) {
+		if (!driver_check_compatible(entry->of_match, &id, compat))
+			return entry;
+	}
+
+	return NULL;
+}
+
 int lists_bind_fdt(struct udevice *parent, ofnode node, struct udevice **devp,
 		   struct driver *drv, bool pre_reloc_only)
 {
@@ -238,20 +353,29 @@ int lists_bind_fdt(struct udevice *parent, ofnode node, struct udevice **devp,
 			  compat);
 
 		id = NULL;
-		for (entry = driver; entry != driver + n_ents; entry++) {
-			if (drv) {
-				if (drv != entry)
-					continue;
-				if (!entry->of_match)
+		ret = -ENOSYS;
+		if (CONFIG_IS_ENABLED(DM_COMPAT_INDEX) && !drv) {
+			ret = lists_compat_find(compat, &entry, &id);
+			if (ret == -ENOENT)
+				continue;
+		}
+		if (ret) {
+			for (entry = driver; entry != driver + n_ents;
+			     entry++) {
+				if (drv) {
+					if (drv != entry)
+						continue;
+					if (!entry->of_match)
+						break;
+				}
+				ret = driver_check_compatible(entry->of_match,
+							      &id, compat);
+				if (!ret)
 					break;
 			}
-			ret = driver_check_compatible(entry->of_match, &id,
-						      compat);
-			if (!ret)
-				break;
+			if (entry == driver + n_ents)
+				continue;
 		}
-		if (entry == driver + n_ents)
-			continue;
 
 		if (pre_reloc_only) {
 			if (!ofnode_pre_reloc(node) &&
@@ -25,6 +25,7 @@
 #include <linux/bug.h>
 #include <linux/libfdt.h>
 #include <dm/of_access.h>
+#include <dm/ofnode.h>
 #include <dm/util.h>
 #include <linux/ctype.h>
 #include <linux/err.h>
@@ -448,15 +449,25 @@ struct device_node *of_find_node_by_prop_value(struct device_node *from,
 struct device_node *of_find_node_by_phandle(struct device_node *root,
 					    phandle handle)
 {
+	bool control = of_live_active() && (!root || root == gd_of_root());
 	struct device_node *np;
+	ofnode node;
 
 	if (!handle)
 		return NULL;
 
+	if (control) {
+		node = ofnode_phandle_cache_find(handle);
+		if (ofnode_valid(node))
+			return (struct device_node *)ofnode_to_np(node);
+	}
+
 	for_each_of_allnodes_from(root, np)
 		if (np->phandle == handle)
 			break;
 	(void)of_node_get(np);
+	if (control)
+		ofnode_phandle_cache_add(handle, np_to_ofnode(np));
 
 	return np;
 }
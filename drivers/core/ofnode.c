@@ -394,6 +394,7 @@ u16 ofnode_read_u16_default(ofnode node, const char *propname, u16 def)
 	return def;
 }
 
+#if !CONFIG_IS_ENABLED(OFNODE_INLINE_READ)
 int ofnode_read_u32(ofnode node, const char *propname, u32 *outp)
 {
 	return ofnode_read_u32_index(node, propname, 0, outp);
@@ -406,6 +407,7 @@ u32 ofnode_read_u32_default(ofnode node, const char *propname, u32 def)
 
 	return def;
 }
+#endif /* !OFNODE_INLINE_READ */
 
 int ofnode_read_u32_index(ofnode node, const char *propname, int index,
 			  u32 *outp)
@@ -477,6 +479,7 @@ u32 ofnode_read_u32_index_default(ofnode node, const char *propname, int index,
 	return def;
 }
 
+#if !CONFIG_IS_ENABLED(OFNODE_INLINE_READ)
 int ofnode_read_s32_default(ofnode node, const char *propname, s32 def)
 {
 	assert(ofnode_valid(node));
@@ -484,6 +487,7 @@ int ofnode_read_s32_default(ofnode node, const char *propname, s32 def)
 
 	return def;
 }
+#endif /* !OFNODE_INLINE_READ */
 
 int ofnode_read_u64(ofnode node, const char *propname, u64 *outp)
 {
@@ -517,6 +521,7 @@ u64 ofnode_read_u64_default(ofnode node, const char *propname, u64 def)
 	return def;
 }
 
+#if !CONFIG_IS_ENABLED(OFNODE_INLINE_READ)
 bool ofnode_read_bool(ofnode node, const char *propname)
 {
 	bool prop;
@@ -530,6 +535,7 @@ bool ofnode_read_bool(ofnode node, const char *propname)
 
 	return prop ? true : false;
 }
+#endif /* !OFNODE_INLINE_READ */
 
 const void *ofnode_read_prop(ofnode node, const char *propname, int *sizep)
 {
@@ -743,6 +749,137 @@ int ofnode_get_path(ofnode node, char *buf, int buflen)
 	}
 }
 
+#define OFNODE_PHANDLE_CACHE_SIZE	64
+
+/**
+ * struct ofnode_phandle_cache - Cache of phandle lookups in the control tree
+ *
+ * Each phandle has a single slot, chosen by its value. Phandles are normally
+ * allocated sequentially, so this spreads them well.
+ *
+ * @tree: Tree the entries refer to: the live tree root, or the control FDT
+ * @phandle: Phandle held in each slot, 0 if the slot is empty
+ * @node: Node held in each slot
+ */
+struct ofnode_phandle_cache {
+	const void *tree;
+	uint phandle[OFNODE_PHANDLE_CACHE_SIZE];
+	ofnode node[OFNODE_PHANDLE_CACHE_SIZE];
+};
+
+int ofnode_phandle_cache_init(void)
+{
+	struct ofnode_phandle_cache *cache = gd_phandle_cache();
+	bool reloc = gd->flags & GD_FLG_RELOC;
+
+	if (!CONFIG_IS_ENABLED(OFNODE_PHANDLE_CACHE))
+		return 0;
+
+	/* Leave the pre-relocation malloc() area to the drivers */
+	if (!IS_ENABLED(CONFIG_XPL_BUILD) && !reloc)
+		return 0;
+
+	/* A cache from before relocation may no longer be accessible */
+	if (!cache || gd_phandle_cache_reloc() != reloc) {
+		cache = malloc(sizeof(*cache));
+		if (!cache)
+			return log_msg_ret("phc", -ENOMEM);
+		gd_set_phandle_cache(cache, reloc);
+	}
+	memset(cache, '\0', sizeof(*cache));
+
+	return 0;
+}
+
+/**
+ * phandle_cache_get() - Get the phandle cache for the control tree
+ *
+ * The cache is emptied if the control tree has changed since it was last used.
+ *
+ * Return: cache, or NULL if there is none in this phase
+ */
+static struct ofnode_phandle_cache *phandle_cache_get(void)
+{
+	struct ofnode_phandle_cache *cache = gd_phandle_cache();
+	bool reloc = gd->flags & GD_FLG_RELOC;
+	const void *tree;
+
+	if (!cache || gd_phandle_cache_reloc() != reloc)
+		return NULL;
+
+	tree = of_live_active() ? (void *)gd_of_root() : gd->fdt_blob;
+	if (cache->tree != tree) {
+		memset(cache, '\0', sizeof(*cache));
+		cache->tree = tree;
+	}
+
+	return cache;
+}
+
+ofnode ofnode_phandle_cache_find(uint phandle)
+{
+	struct ofnode_phandle_cache *cache = phandle_cache_get();
+	int slot = phandle % OFNODE_PHANDLE_CACHE_SIZE;
+	ofnode node;
+
+	if (!cache || !phandle || cache->phandle[slot] != phandle)
+		return ofnode_null();
+
+	node = cache->node[slot];
+	if (of_live_active()) {
+		if (ofnode_to_np(node)->phandle == phandle)
+			return node;
+	} else {
+		if (fdt_get_phandle(gd->fdt_blob,
+				    ofnode_to_offset(node)) == phandle)
+			return node;
+	}
+	cache->phandle[slot] = 0;
+
+	return ofnode_null();
+}
+
+void ofnode_phandle_cache_add(uint phandle, ofnode node)
+{
+	struct ofnode_phandle_cache *cache = phandle_cache_get();
+	int slot = phandle % OFNODE_PHANDLE_CACHE_SIZE;
+
+	if (!cache || !phandle || !ofnode_valid(node))
+		return;
+
+	cache->phandle[slot] = phandle;
+	cache->node[slot] = node;
+}
+
+void ofnode_phandle_cache_clear(void)
+{
+	struct ofnode_phandle_cache *cache = phandle_cache_get();
+
+	if (cache)
+		memset(cache->phandle, '\0', sizeof(cache->phandle));
+}
+
+/**
+ * fdt_get_by_phandle() - Look up a phandle in the control FDT
+ *
+ * @phandle: Phandle to look up
+ * Return: node with that phandle, or a node with a -ve offset if not found
+ */
+static ofnode fdt_get_by_phandle(uint phandle)
+{
+	ofnode node;
+
+	node = ofnode_phandle_cache_find(phandle);
+	if (ofnode_valid(node))
+		return node;
+
+	node = offset_to_ofnode(fdt_node_offset_by_phandle(gd->fdt_blob,
+							   phandle));
+	ofnode_phandle_cache_add(phandle, node);
+
+	return node;
+}
+
 ofnode ofnode_get_by_phandle(uint phandle)
 {
 	ofnode node;
@@ -750,8 +887,7 @@ ofnode ofnode_get_by_phandle(uint phandle)
 	if (of_live_active())
 		node = np_to_ofnode(of_find_node_by_phandle(NULL, phandle));
 	else
-		node.of_offset = fdt_node_offset_by_phandle(gd->fdt_blob,
-							    phandle);
+		node = fdt_get_by_phandle(phandle);
 
 	return node;
 }
@@ -762,6 +898,8 @@ ofnode oftree_get_by_phandle(oftree tree, uint phandle)
 
 	if (of_live_active())
 		node = np_to_ofnode(of_find_node_by_phandle(tree.np, phandle));
+	else if (oftree_lookup_fdt(tree) == gd->fdt_blob)
+		node = fdt_get_by_phandle(phandle);
 	else
 		node = ofnode_from_tree_offset(tree,
 			fdt_node_offset_by_phandle(oftree_lookup_fdt(tree),
@@ -1327,6 +1465,7 @@ int ofnode_decode_panel_timing(ofnode parent,
 	return ret;
 }
 
+#if !CONFIG_IS_ENABLED(OFNODE_INLINE_READ)
 const void *ofnode_get_property(ofnode node, const char *propname, int *lenp)
 {
 	if (ofnode_is_np(node))
@@ -1343,6 +1482,7 @@ bool ofnode_has_property(ofnode node, const char *propname)
 	else
 		return ofnode_get_property(node, propname, NULL);
 }
+#endif /* !OFNODE_INLINE_READ */
 
 int ofnode_first_property(ofnode node, struct ofprop *prop)
 {
@@ -2066,6 +2206,8 @@ int ofnode_delete(ofnode *nodep)
 	assert(ofnode_valid(node));
 	if (ofnode_is_np(node)) {
 		ret = of_remove_node(ofnode_to_np(node));
+		if (!ret)
+			ofnode_phandle_cache_clear();
 	} else {
 		void *fdt = ofnode_to_fdt(node);
 		int offset = ofnode_to_offset(node);
@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Fixed-size pools for driver model data
+ *
+ * Each pool holds objects of one size, carved from slabs which are allocated
+ * with malloc(). Each slab keeps a list of its free objects, threaded through
+ * the objects themselves, and is freed when none of its objects are in use.
+ * The slabs of all pools are also kept in an array sorted by address, so that
+ * freeing an object can find its slab with a binary search.
+ */
+
+#define LOG_CATEGORY LOGC_DM
+
+#include <dm.h>
+#include <log.h>
+#include <malloc.h>
+#include <asm/global_data.h>
+#include <dm/device-internal.h>
+#include <dm/root.h>
+#include <linux/kernel.h>
+
+DECLARE_GLOBAL_DATA_PTR;
+
+/* Alignment of each object, which is also the unit of object sizes */
+#define DM_POOL_ALIGN		16
+
+/* Number of objects in the first slab of each pool, doubling up to the max */
+#define DM_POOL_MIN_OBJS	4
+#define DM_POOL_MAX_OBJS	32
+
+/* Initial number of entries in the slab index */
+#define DM_POOL_INDEX_MIN	16
+
+/**
+ * struct dm_pool_slab - A block of objects allocated with malloc()
+ *
+ * @next: Next slab in the pool, or NULL
+ * @cls: Pool which the slab belongs to
+ * @end: Address just after the last object
+ * @free_list: First free object in this slab, or NULL if none
+ * @count: Number of objects in the slab
+ * @used: Number of objects in use
+ * @objs: Start of the objects
+ */
+struct dm_pool_slab {
+	struct dm_pool_slab *next;
+	struct dm_pool_class *cls;
+	void *end;
+	void *free_list;
+	int count;
+	int used;
+	u8 objs[] __aligned(DM_POOL_ALIGN);
+};
+
+/**
+ * struct dm_pool_class - A pool of objects of a particular size
+ *
+ * @size: Size of each object in bytes
+ * @next_count: Number of objects to put in the next slab
+ * @slabs: List of slabs
+ * @stats: Usage information
+ */
+struct dm_pool_class {
+	int size;
+	int next_count;
+	struct dm_pool_slab *slabs;
+	struct dm_pool_stats stats;
+};
+
+/**
+ * struct dm_pool - All driver model pools
+ *
+ * @pool: Pools in order of increasing object size
+ * @index: Slabs of all pools, in order of increasing address
+ * @index_count: Number of slabs in @index
+ * @index_size: Number of entries allocated for @index
+ */
+struct dm_pool {
+	struct dm_pool_class pool[DM_POOL_COUNT];
+	struct dm_pool_slab **index;
+	int index_count;
+	int index_size;
+};
+
+int dm_pool_init(void)
+{
+	int sizes[DM_POOL_COUNT] = { 16, 32, 64, 128 };
+	int dev_size = ALIGN(sizeof(struct udevice), DM_POOL_ALIGN);
+	struct dm_pool *pool;
+	int i;
+
+	pool = calloc(1, sizeof(*pool));
+	if (!pool)
+		return log_msg_ret("pool", -ENOMEM);
+
+	/* Add a pool sized for struct udevice, keeping the sizes in order */
+	for (i = 0; i < DM_POOL_COUNT - 1 && sizes[i] < dev_size; i++)
+		;
+	if (i < DM_POOL_COUNT - 1 && sizes[i] == dev_size) {
+		sizes[DM_POOL_COUNT - 1] = sizes[DM_POOL_COUNT - 2] * 2;
+	} else {
+		memmove(&sizes[i + 1], &sizes[i],
+			(DM_POOL_COUNT - 1 - i) * sizeof(int));
+		sizes[i] = dev_size;
+	}
+
+	for (i = 0; i < DM_POOL_COUNT; i++) {
+		pool->pool[i].size = sizes[i];
+		pool->pool[i].next_count = DM_POOL_MIN_OBJS;
+		pool->pool[i].stats.size = sizes[i];
+	}
+	gd_set_dm_pool(pool);
+
+	return 0;
+}
+
+void dm_pool_uninit(void)
+{
+	struct dm_pool *pool = gd_dm_pool();
+	struct dm_pool_slab *slab, *next;
+	int i;
+
+	if (!pool)
+		return;
+	for (i = 0; i < DM_POOL_COUNT; i++) {
+		for (slab = pool->pool[i].slabs; slab; slab = next) {
+			next = slab->next;
+			free(slab);
+		}
+	}
+	free(pool->index);
+	free(pool);
+	gd_set_dm_pool(NULL);
+}
+
+/**
+ * pool_index_find() - Find where an address lies in the slab index
+ *
+ * @pool: Pools to search
+ * @ptr: Address to look for
+ * Return: number of slabs in the index which start at or below @ptr
+ */
+static int pool_index_find(struct dm_pool *pool, const void *ptr)
+{
+	int lo = 0, hi = pool->index_count;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+
+		if ((void *)pool->index[mid] <= ptr)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+/**
+ * pool_add_slab() - Add a new slab to a pool
+ *
+ * @pool: Pools to update
+ * @cls: Pool to update
+ * Return: new slab, or NULL if out of memory
+ */
+static struct dm_pool_slab *pool_add_slab(struct dm_pool *pool,
+					  struct dm_pool_class *cls)
+{
+	struct dm_pool_slab *slab;
+	int count = cls->next_count;
+	void *obj;
+	int pos;
+
+	if (pool->index_count == pool->index_size) {
+		int size = max(pool->index_size * 2, DM_POOL_INDEX_MIN);
+		struct dm_pool_slab **index;
+
+		index = realloc(pool->index, size * sizeof(*index));
+		if (!index)
+			return NULL;
+		pool->index = index;
+		pool->index_size = size;
+	}
+
+	slab = memalign(DM_POOL_ALIGN, sizeof(*slab) + count * cls->size);
+	if (!slab)
+		return NULL;
+	pos = pool_index_find(pool, slab);
+	memmove(&pool->index[pos + 1], &pool->index[pos],
+		(pool->index_count - pos) * sizeof(*pool->index));
+	pool->index[pos] = slab;
+	pool->index_count++;
+
+	slab->cls = cls;
+	slab->end = slab->objs + count * cls->size;
+	slab->free_list = NULL;
+	for (obj = slab->end - cls->size; obj >= (void *)slab->objs;
+	     obj -= cls->size) {
+		*(void **)obj = slab->free_list;
+		slab->free_list = obj;
+	}
+	slab->count = count;
+	slab->used = 0;
+	slab->next = cls->slabs;
+	cls->slabs = slab;
+	cls->stats.slab_count++;
+	cls->stats.total += count;
+	cls->next_count = min(count * 2, DM_POOL_MAX_OBJS);
+
+	return slab;
+}
+
+void *dm_pool_alloc(int size)
+{
+	struct dm_pool *pool = gd_dm_pool();
+	struct dm_pool_class *cls;
+	struct dm_pool_slab *slab;
+	void *obj;
+
+	if (!pool || size > pool->pool[DM_POOL_COUNT - 1].size)
+		return calloc(1, size);
+
+	for (cls = pool->pool; cls->size < size; cls++)
+		;
+	for (slab = cls->slabs; slab && !slab->free_list; slab = slab->next)
+		;
+	if (!slab) {
+		slab = pool_add_slab(pool, cls);
+		if (!slab)
+			return NULL;
+	}
+	obj = slab->free_list;
+	slab->free_list = *(void **)obj;
+	slab->used++;
+	cls->stats.used++;
+	memset(obj, '\0', cls->size);
+
+	return obj;
+}
+
+void dm_pool_free(void *ptr)
+{
+	struct dm_pool *pool = gd_dm_pool();
+	struct dm_pool_slab *slab, **slabp;
+	struct dm_pool_class *cls;
+	int pos;
+
+	if (!ptr)
+		return;
+	if (!pool) {
+		free(ptr);
+		return;
+	}
+
+	/* Anything not inside a slab came from malloc() */
+	pos = pool_index_find(pool, ptr) - 1;
+	if (pos < 0 || ptr < (void *)pool->index[pos]->objs ||
+	    ptr >= pool->index[pos]->end) {
+		free(ptr);
+		return;
+	}
+	slab = pool->index[pos];
+	cls = slab->cls;
+	*(void **)ptr = slab->free_list;
+	slab->free_list = ptr;
+	slab->used--;
+	cls->stats.used--;
+
+	/* Give an empty slab back, so the heap can reuse it */
+	if (!slab->used) {
+		for (slabp = &cls->slabs; *slabp != slab;
+		     slabp = &(*slabp)->next)
+			;
+		*slabp = slab->next;
+		memmove(&pool->index[pos], &pool->index[pos + 1],
+			(pool->index_count - pos - 1) * sizeof(*pool->index));
+		pool->index_count--;
+		cls->stats.slab_count--;
+		cls->stats.total -= slab->count;
+		free(slab);
+	}
+}
+
+void dm_pool_get_stats(struct dm_pool_stats *stats)
+{
+	struct dm_pool *pool = gd_dm_pool();
+	int i;
+
+	for (i = 0; i < DM_POOL_COUNT; i++) {
+		if (pool)
+			stats[i] = pool->pool[i].stats;
+		else
+			memset(&stats[i], '\0', sizeof(stats[i]));
+	}
+}
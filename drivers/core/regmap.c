@@ -36,6 +36,19 @@ struct regmap_field {
 	unsigned int reg;
 };
 
+/**
+ * struct regmap_cache - Cached register values for a regmap
+ *
+ * @count:	Number of registers in the cache, starting at offset 0
+ * @vals:	Value of each register, valid only if its bit in @valid is set
+ * @valid:	Bitmap of registers which have a value in @vals
+ */
+struct regmap_cache {
+	uint count;
+	uint *vals;
+	ulong valid[];
+};
+
 DECLARE_GLOBAL_DATA_PTR;
 
 /**
@@ -78,6 +91,21 @@ static struct regmap *regmap_alloc(int count)
 	return map;
 }
 
+/**
+ * regmap_set_fast_path() - Work out whether a regmap can use the fast path
+ *
+ * This must be called whenever the width, endianness or offset shift of a
+ * regmap changes.
+ *
+ * @map: Regmap to update
+ */
+static void regmap_set_fast_path(struct regmap *map)
+{
+	map->fast_path = map->width == REGMAP_SIZE_32 &&
+			 map->endianness == REGMAP_NATIVE_ENDIAN &&
+			 !map->reg_offset_shift && map->range_count > 0;
+}
+
 #if CONFIG_IS_ENABLED(OF_PLATDATA)
 int regmap_init_mem_plat(struct udevice *dev, void *reg, int size, int count,
 			 struct regmap **mapp)
@@ -108,6 +136,7 @@ int regmap_init_mem_plat(struct udevice *dev, void *reg, int size, int count,
 	} else {
 		return -EINVAL;
 	}
+	regmap_set_fast_path(map);
 
 	*mapp = map;
 
@@ -205,6 +234,7 @@ int regmap_init_mem_index(ofnode node, struct regmap **mapp, int index)
 		map->endianness = REGMAP_NATIVE_ENDIAN;
 	else /* Default: native endianness */
 		map->endianness = REGMAP_NATIVE_ENDIAN;
+	regmap_set_fast_path(map);
 
 	*mapp = map;
 
@@ -237,6 +267,7 @@ int regmap_init_mem_range(ofnode node, ulong r_start, ulong r_size,
 		map->endianness = REGMAP_NATIVE_ENDIAN;
 	else /* Default: native endianness */
 		map->endianness = REGMAP_NATIVE_ENDIAN;
+	regmap_set_fast_path(map);
 
 	*mapp = map;
 	return 0;
@@ -309,6 +340,7 @@ int regmap_init_mem(ofnode node, struct regmap **mapp)
 		map->endianness = REGMAP_NATIVE_ENDIAN;
 	else /* Default: native endianness */
 		map->endianness = REGMAP_NATIVE_ENDIAN;
+	regmap_set_fast_path(map);
 
 	*mapp = map;
 
@@ -350,6 +382,15 @@ struct regmap *devm_regmap_init(struct udevice *dev,
 	if (config) {
 		map->width = config->width;
 		map->reg_offset_shift = config->reg_offset_shift;
+		regmap_set_fast_path(map);
+		if (config->cache_regs) {
+			rc = regmap_init_cache(map, config->cache_regs);
+			if (rc) {
+				regmap_uninit(map);
+				devres_free(mapp);
+				return ERR_PTR(rc);
+			}
+		}
 	}
 
 	devres_add(dev, mapp);
@@ -368,8 +409,86 @@ void *regmap_get_range(struct regmap *map, unsigned int range_num)
 	return map_sysmem(range->start, range->size);
 }
 
+int regmap_init_cache(struct regmap *map, uint count)
+{
+	struct regmap_cache *cache;
+	uint longs = BITS_TO_LONGS(count);
+
+	free(map->cache);
+	map->cache = NULL;
+	if (!count)
+		return 0;
+
+	cache = calloc(1, sizeof(*cache) + longs * sizeof(ulong) +
+		       count * sizeof(uint));
+	if (!cache)
+		return -ENOMEM;
+	cache->count = count;
+	cache->vals = (uint *)(cache->valid + longs);
+	map->cache = cache;
+
+	return 0;
+}
+
+void regmap_cache_drop(struct regmap *map)
+{
+	struct regmap_cache *cache = map->cache;
+
+	if (cache)
+		memset(cache->valid, '\0',
+		       BITS_TO_LONGS(cache->count) * sizeof(ulong));
+}
+
+/**
+ * regmap_cache_index() - Find the cache slot for a register
+ *
+ * @map:	Regmap to check, which must have a cache
+ * @offset:	Offset of the register in range 0
+ * Return: index into the cache, or -1 if the register is not cached, e.g.
+ *	because the offset is not aligned to the register width
+ */
+static int regmap_cache_index(struct regmap *map, uint offset)
+{
+	uint pos = offset << map->reg_offset_shift;
+
+	if (pos % map->width || pos / map->width >= map->cache->count)
+		return -1;
+
+	return pos / map->width;
+}
+
+static void regmap_cache_set(struct regmap *map, int idx, uint val)
+{
+	struct regmap_cache *cache = map->cache;
+
+	if (map->width == REGMAP_SIZE_8)
+		val &= 0xff;
+	else if (map->width == REGMAP_SIZE_16)
+		val &= 0xffff;
+	cache->vals[idx] = val;
+	cache->valid[BIT_WORD(idx)] |= BIT_MASK(idx);
+}
+
+/**
+ * regmap_cache_invalidate() - Drop registers written outside the cache
+ *
+ * @map:	Regmap to update, which must have a cache
+ * @pos:	Byte position of the write within range 0
+ * @len:	Number of bytes written
+ */
+static void regmap_cache_invalidate(struct regmap *map, uint pos, size_t len)
+{
+	struct regmap_cache *cache = map->cache;
+	uint idx, last;
+
+	last = min_t(uint, (pos + len - 1) / map->width, cache->count - 1);
+	for (idx = pos / map->width; idx <= last; idx++)
+		cache->valid[BIT_WORD(idx)] &= ~BIT_MASK(idx);
+}
+
 int regmap_uninit(struct regmap *map)
 {
+	free(map->cache);
 	free(map);
 
 	return 0;
@@ -474,7 +593,27 @@ int regmap_raw_read(struct regmap *map, uint offset, void *valp, size_t val_len)
 	return regmap_raw_read_range(map, 0, offset, valp, val_len);
 }
 
-int regmap_read(struct regmap *map, uint offset, uint *valp)
+/**
+ * regmap_check_fast() - Check an access to range 0 on the fast path
+ *
+ * @map:	Regmap to check
+ * @offset:	Byte offset of the access
+ * @len:	Number of bytes to access
+ * Return: 0 if OK, -ERANGE if the access is outside range 0
+ */
+static int regmap_check_fast(struct regmap *map, uint offset, size_t len)
+{
+	struct regmap_range *range = &map->ranges[0];
+
+	if (offset + len > range->size || offset + len < offset) {
+		dm_warn("%s: offset/size combination invalid\n", __func__);
+		return -ERANGE;
+	}
+
+	return 0;
+}
+
+static int regmap_read_hw(struct regmap *map, uint offset, uint *valp)
 {
 	union {
 		u8 v8;
@@ -484,6 +623,14 @@ int regmap_read(struct regmap *map, uint offset, uint *valp)
 	} u;
 	int res;
 
+	if (map->fast_path) {
+		if (regmap_check_fast(map, offset, sizeof(u32)))
+			return -ERANGE;
+		*valp = readl(map_physmem(map->ranges[0].start + offset,
+					  sizeof(u32), MAP_NOCACHE));
+		return 0;
+	}
+
 	res = regmap_raw_read(map, offset, &u, map->width);
 	if (res)
 		return res;
@@ -508,6 +655,29 @@ int regmap_read(struct regmap *map, uint offset, uint *valp)
 	return 0;
 }
 
+int regmap_read(struct regmap *map, uint offset, uint *valp)
+{
+	int idx = -1;
+	int ret;
+
+	if (map->cache) {
+		idx = regmap_cache_index(map, offset);
+		if (idx >= 0 && (map->cache->valid[BIT_WORD(idx)] &
+				 BIT_MASK(idx))) {
+			*valp = map->cache->vals[idx];
+			return 0;
+		}
+	}
+
+	ret = regmap_read_hw(map, offset, valp);
+	if (ret)
+		return ret;
+	if (idx >= 0)
+		regmap_cache_set(map, idx, *valp);
+
+	return 0;
+}
+
 static inline void __write_8(u8 *addr, const u8 *val,
 			     enum regmap_endianness_t endianness)
 {
@@ -564,8 +734,9 @@ static inline void __write_64(u64 *addr, const u64 *val,
 }
 #endif
 
-int regmap_raw_write_range(struct regmap *map, uint range_num, uint offset,
-			   const void *val, size_t val_len)
+static int __regmap_raw_write_range(struct regmap *map, uint range_num,
+				    uint offset, const void *val,
+				    size_t val_len)
 {
 	struct regmap_range *range;
 	void *ptr;
@@ -608,13 +779,28 @@ int regmap_raw_write_range(struct regmap *map, uint range_num, uint offset,
 	return 0;
 }
 
+int regmap_raw_write_range(struct regmap *map, uint range_num, uint offset,
+			   const void *val, size_t val_len)
+{
+	int ret;
+
+	ret = __regmap_raw_write_range(map, range_num, offset, val, val_len);
+	if (ret)
+		return ret;
+	if (map->cache && !range_num)
+		regmap_cache_invalidate(map, offset << map->reg_offset_shift,
+					val_len);
+
+	return 0;
+}
+
 int regmap_raw_write(struct regmap *map, uint offset, const void *val,
 		     size_t val_len)
 {
 	return regmap_raw_write_range(map, 0, offset, val, val_len);
 }
 
-int regmap_write(struct regmap *map, uint offset, uint val)
+static int regmap_write_hw(struct regmap *map, uint offset, uint val)
 {
 	union {
 		u8 v8;
@@ -623,6 +809,14 @@ int regmap_write(struct regmap *map, uint offset, uint val)
 		u64 v64;
 	} u;
 
+	if (map->fast_path) {
+		if (regmap_check_fast(map, offset, sizeof(u32)))
+			return -ERANGE;
+		writel(val, map_physmem(map->ranges[0].start + offset,
+					sizeof(u32), MAP_NOCACHE));
+		return 0;
+	}
+
 	switch (map->width) {
 	case REGMAP_SIZE_8:
 		u.v8 = val;
@@ -642,21 +836,114 @@ int regmap_write(struct regmap *map, uint offset, uint val)
 		return -EINVAL;
 	}
 
-	return regmap_raw_write(map, offset, &u, map->width);
+	return __regmap_raw_write_range(map, 0, offset, &u, map->width);
+}
+
+int regmap_write(struct regmap *map, uint offset, uint val)
+{
+	int ret;
+	int idx;
+
+	ret = regmap_write_hw(map, offset, val);
+	if (ret)
+		return ret;
+	if (map->cache) {
+		idx = regmap_cache_index(map, offset);
+		if (idx >= 0)
+			regmap_cache_set(map, idx, val);
+	}
+
+	return 0;
 }
 
 int regmap_update_bits(struct regmap *map, uint offset, uint mask, uint val)
 {
-	uint reg;
+	uint reg, new;
 	int ret;
 
 	ret = regmap_read(map, offset, &reg);
 	if (ret)
 		return ret;
 
-	reg &= ~mask;
+	new = (reg & ~mask) | (val & mask);
+
+	/* A cached register already holds this value, so skip the write */
+	if (new == reg && map->cache && regmap_cache_index(map, offset) >= 0)
+		return 0;
 
-	return regmap_write(map, offset, reg | (val & mask));
+	return regmap_write(map, offset, new);
+}
+
+/**
+ * regmap_bulk_stride() - Get the offset between consecutive registers
+ *
+ * @map:	Regmap to check
+ * Return: difference in offset between one register and the next
+ */
+static uint regmap_bulk_stride(struct regmap *map)
+{
+	return max_t(uint, map->width >> map->reg_offset_shift, 1);
+}
+
+int regmap_bulk_read(struct regmap *map, uint offset, void *val, size_t count)
+{
+	uint stride;
+	int ret;
+
+	if (map->fast_path && !map->cache) {
+		u32 *buf = val;
+		u32 *ptr;
+
+		ret = regmap_check_fast(map, offset, count * sizeof(u32));
+		if (ret)
+			return ret;
+		ptr = map_physmem(map->ranges[0].start + offset,
+				  count * sizeof(u32), MAP_NOCACHE);
+		while (count--)
+			*buf++ = readl(ptr++);
+
+		return 0;
+	}
+
+	stride = regmap_bulk_stride(map);
+	for (; count; count--, offset += stride, val += map->width) {
+		ret = regmap_raw_read(map, offset, val, map->width);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+int regmap_bulk_write(struct regmap *map, uint offset, const void *val,
+		      size_t count)
+{
+	uint stride;
+	int ret;
+
+	if (map->fast_path && !map->cache) {
+		const u32 *buf = val;
+		u32 *ptr;
+
+		ret = regmap_check_fast(map, offset, count * sizeof(u32));
+		if (ret)
+			return ret;
+		ptr = map_physmem(map->ranges[0].start + offset,
+				  count * sizeof(u32), MAP_NOCACHE);
+		while (count--)
+			writel(*buf++, ptr++);
+
+		return 0;
+	}
+
+	stride = regmap_bulk_stride(map);
+	for (; count; count--, offset += stride, val += map->width) {
+		ret = regmap_raw_write(map, offset, val, map->width);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
 }
 
 int regmap_field_read(struct regmap_field *field, unsigned int *val)
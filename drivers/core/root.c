@@ -8,14 +8,17 @@
 
 #define LOG_CATEGORY UCLASS_ROOT
 
+#include <bootstage.h>
 #include <errno.h>
 #include <fdtdec.h>
 #include <log.h>
 #include <malloc.h>
+#include <sort.h>
 #include <asm-generic/sections.h>
 #include <asm/global_data.h>
 #include <linux/libfdt.h>
 #include <dm/acpi.h>
+#include <dm/devres.h>
 #include <dm/device.h>
 #include <dm/device-internal.h>
 #include <dm/lists.h>
@@ -28,6 +31,7 @@
 #include <dm/uclass-internal.h>
 #include <dm/util.h>
 #include <linux/list.h>
+#include <uthread.h>
 #include <linux/printk.h>
 
 DECLARE_GLOBAL_DATA_PTR;
@@ -53,6 +57,7 @@ void dm_fixup_for_gd_move(struct global_data *new_gd)
 		new_gd->uclass_root->next->prev = new_gd->uclass_root;
 		new_gd->uclass_root->prev->next = new_gd->uclass_root;
 	}
+	/* The uclass table is in the malloc() area, so has not moved */
 }
 
 static int dm_setup_inst(void)
@@ -91,6 +96,37 @@ static int dm_setup_inst(void)
 	return 0;
 }
 
+/**
+ * dm_setup_uclass_table() - Set up the table used to look up uclasses by ID
+ *
+ * The table is reused if it already exists, e.g. when driver model is
+ * restarted by tests. In U-Boot proper it is only allocated after relocation,
+ * since the pre-relocation malloc() area may be too small to hold it. If it
+ * cannot be allocated, uclass_find() walks the uclass list instead.
+ *
+ * Return: 0 if OK, -ENOMEM if out of memory
+ */
+static int dm_setup_uclass_table(void)
+{
+	struct uclass **table = gd_uclass_table();
+	struct uclass *uc;
+
+	if (table) {
+		memset(table, '\0', UCLASS_COUNT * sizeof(*table));
+	} else {
+		table = calloc(UCLASS_COUNT, sizeof(*table));
+		if (!table)
+			return log_msg_ret("uct", -ENOMEM);
+		gd_set_uclass_table(table);
+	}
+
+	/* With OF_PLATDATA_INST the uclasses are already in the list */
+	list_for_each_entry(uc, gd->uclass_root, sibling_node)
+		table[uc->uc_drv->id] = uc;
+
+	return 0;
+}
+
 int dm_init(bool of_live)
 {
 	int ret;
@@ -106,6 +142,21 @@ int dm_init(bool of_live)
 		INIT_LIST_HEAD(DM_UCLASS_ROOT_NON_CONST);
 	}
 
+	/* Before full malloc() is ready, slabs would just waste its space */
+	if (CONFIG_IS_ENABLED(DM_POOL) &&
+	    (gd->flags & GD_FLG_FULL_MALLOC_INIT)) {
+		ret = dm_pool_init();
+		if (ret)
+			log_debug("No pools (err=%d)\n", ret);
+	}
+
+	if (CONFIG_IS_ENABLED(DM_UCLASS_TABLE) &&
+	    (IS_ENABLED(CONFIG_XPL_BUILD) || (gd->flags & GD_FLG_RELOC))) {
+		ret = dm_setup_uclass_table();
+		if (ret)
+			log_debug("No uclass table (err=%d)\n", ret);
+	}
+
 	if (CONFIG_IS_ENABLED(OF_PLATDATA_INST)) {
 		ret = dm_setup_inst();
 		if (ret) {
@@ -126,16 +177,43 @@ int dm_init(bool of_live)
 
 	INIT_LIST_HEAD((struct list_head *)&gd->dmtag_list);
 
+	if (CONFIG_IS_ENABLED(OFNODE_PHANDLE_CACHE)) {
+		ret = ofnode_phandle_cache_init();
+		if (ret)
+			log_debug("No phandle cache (err=%d)\n", ret);
+	}
+
+	if (CONFIG_IS_ENABLED(DM_COMPAT_INDEX) && !gd_dm_compat_index()) {
+		ret = lists_compat_index_init();
+		if (ret)
+			log_debug("No compatible index (err=%d)\n", ret);
+	}
+
+	if (CONFIG_IS_ENABLED(DM_LAZY_BIND) && (gd->flags & GD_FLG_RELOC) &&
+	    ofnode_options_read_bool("dm-lazy-bind")) {
+		ret = dm_lazy_init();
+		if (ret)
+			log_debug("No lazy binding (err=%d)\n", ret);
+	}
+
 	return 0;
 }
 
 int dm_uninit(void)
 {
+	/* Don't bind recorded nodes while tearing down */
+	dm_lazy_uninit();
+
 	/* Remove non-vital devices first */
 	device_remove(dm_root(), DM_REMOVE_NON_VITAL);
 	device_remove(dm_root(), DM_REMOVE_NORMAL);
 	device_unbind(dm_root());
 	gd->dm_root = NULL;
+	free(gd_uclass_table());
+	gd_set_uclass_table(NULL);
+	free(gd_dm_compat_index());
+	gd_set_dm_compat_index(NULL, 0);
+	dm_pool_uninit();
 
 	return 0;
 }
@@ -211,6 +289,8 @@ static int dm_scan_fdt_node(struct udevice *parent, ofnode parent_node,
 			pr_debug("   - ignoring disabled device\n");
 			continue;
 		}
+		if (dm_lazy_defer(parent, node, pre_reloc_only))
+			continue;
 		err = lists_bind_fdt(parent, node, NULL, NULL, pre_reloc_only);
 		if (err && !ret) {
 			ret = err;
@@ -288,11 +368,27 @@ void *dm_priv_to_rw(void *priv)
 }
 #endif
 
+/**
+ * dm_probe_in_thread() - Check whether a device is left for a probe thread
+ *
+ * @dev: Device to check
+ * Return: true if dm_autoprobe() probes @dev in a thread, false if directly
+ */
+static bool dm_probe_in_thread(struct udevice *dev)
+{
+	/* Threads need the full malloc() area for their stacks */
+	return CONFIG_IS_ENABLED(DM_PROBE_THREADS) &&
+	       (gd->flags & GD_FLG_RELOC) &&
+	       (dev_get_flags(dev) & DM_FLAG_PROBE_AFTER_BIND) &&
+	       (dev->driver->flags & DM_FLAG_PROBE_THREAD);
+}
+
 /**
  * dm_probe_devices() - Check whether to probe a device and all children
  *
- * Probes the device if DM_FLAG_PROBE_AFTER_BIND is enabled for it. Then scans
- * all its children recursively to do the same.
+ * Probes the device if DM_FLAG_PROBE_AFTER_BIND is enabled for it, unless it
+ * is left for a probe thread. Then scans all its children recursively to do
+ * the same.
  *
  * @dev: Device to (maybe) probe
  * @pre_reloc_only: Probe only devices marked with the DM_FLAG_PRE_RELOC flag
@@ -309,7 +405,8 @@ static int dm_probe_devices(struct udevice *dev, bool pre_reloc_only)
 	    !(dev->driver->flags & DM_FLAG_PRE_RELOC))
 		goto probe_children;
 
-	if (dev_get_flags(dev) & DM_FLAG_PROBE_AFTER_BIND) {
+	if ((dev_get_flags(dev) & DM_FLAG_PROBE_AFTER_BIND) &&
+	    !dm_probe_in_thread(dev)) {
 		ret = device_probe(dev);
 		if (ret)
 			return ret;
@@ -322,6 +419,125 @@ probe_children:
 	return 0;
 }
 
+#if CONFIG_IS_ENABLED(DM_PROBE_THREADS)
+/**
+ * struct dm_probe_bus - A bus whose children are probed in a thread
+ *
+ * @bus: Parent of the devices to probe
+ * @ret: First error from probing them, or 0
+ * @next: Next bus, or NULL
+ */
+struct dm_probe_bus {
+	struct udevice *bus;
+	int ret;
+	struct dm_probe_bus *next;
+};
+
+static void dm_probe_bus_thread(void *arg)
+{
+	struct dm_probe_bus *pb = arg;
+	struct udevice *child;
+	int ret;
+
+	list_for_each_entry(child, &pb->bus->child_head, sibling_node) {
+		if (!dm_probe_in_thread(child))
+			continue;
+		ret = device_probe(child);
+		if (ret) {
+			log_debug("%s: probe failed (err=%d)\n", child->name,
+				  ret);
+			if (!pb->ret)
+				pb->ret = ret;
+		}
+	}
+}
+
+/**
+ * dm_probe_start_threads() - Start a thread for each bus needing probing
+ *
+ * Walks the subtree at @dev. Each device with children left for a probe
+ * thread gets one thread, which probes those children in turn. This keeps
+ * the devices on a bus from using it at the same time. If a thread cannot be
+ * created the children are probed directly.
+ *
+ * @dev: Device to start from
+ * @grp_id: Thread group to use
+ * @headp: List to add each bus to
+ * Return: 0 if OK, -ENOMEM if out of memory
+ */
+static int dm_probe_start_threads(struct udevice *dev, uint grp_id,
+				  struct dm_probe_bus **headp)
+{
+	struct dm_probe_bus *pb;
+	struct udevice *child;
+	bool found = false;
+	int ret;
+
+	list_for_each_entry(child, &dev->child_head, sibling_node) {
+		if (dm_probe_in_thread(child)) {
+			found = true;
+			break;
+		}
+	}
+	if (found) {
+		pb = calloc(1, sizeof(*pb));
+		if (!pb)
+			return -ENOMEM;
+		pb->bus = dev;
+		pb->next = *headp;
+		*headp = pb;
+		if (uthread_create(NULL, dm_probe_bus_thread, pb, 0, grp_id))
+			dm_probe_bus_thread(pb);
+	}
+	list_for_each_entry(child, &dev->child_head, sibling_node) {
+		ret = dm_probe_start_threads(child, grp_id, headp);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * dm_probe_devices_threaded() - Probe devices in parallel
+ *
+ * Devices whose drivers have DM_FLAG_PROBE_THREAD are probed with one thread
+ * per bus. device_probe() probes the parents of a device first, so where
+ * threads share a parent, or a supplier, the first thread to get to it probes
+ * it and the others wait for that probe to finish.
+ *
+ * Return: 0 if OK, -ve on error
+ */
+static int dm_probe_devices_threaded(void)
+{
+	struct dm_probe_bus *head = NULL, *pb;
+	uint grp_id;
+	int ret;
+
+	grp_id = uthread_grp_new_id();
+	ret = dm_probe_start_threads(gd->dm_root, grp_id, &head);
+
+	/* Any threads which were started must finish before returning */
+	while (!uthread_grp_done(grp_id))
+		uthread_schedule();
+
+	while (head) {
+		pb = head;
+		if (!ret)
+			ret = pb->ret;
+		head = pb->next;
+		free(pb);
+	}
+
+	return ret;
+}
+#else
+static int dm_probe_devices_threaded(void)
+{
+	return 0;
+}
+#endif
+
 int dm_autoprobe(void)
 {
 	int ret;
@@ -330,6 +546,12 @@ int dm_autoprobe(void)
 	if (ret)
 		return log_msg_ret("pro", ret);
 
+	if (CONFIG_IS_ENABLED(DM_PROBE_THREADS) && (gd->flags & GD_FLG_RELOC)) {
+		ret = dm_probe_devices_threaded();
+		if (ret)
+			return log_msg_ret("thr", ret);
+	}
+
 	return 0;
 }
 
@@ -448,12 +670,117 @@ void dm_get_mem(struct dm_stats *stats)
 	dev_collect_stats(stats, gd->dm_root);
 	uclass_collect_stats(stats);
 	dev_tag_collect_stats(stats);
+	dm_pool_get_stats(stats->pool);
 
 	stats->total_size = stats->dev_size + stats->uc_size +
 		stats->attach_size_total + stats->uc_attach_size +
 		stats->tag_size;
 }
 
+ulong dev_get_mem(const struct udevice *dev)
+{
+	ulong mem;
+	int i;
+
+	mem = sizeof(struct udevice);
+	if (dev_get_flags(dev) & DM_FLAG_NAME_ALLOCED)
+		mem += strlen(dev->name) + 1;
+	for (i = 0; i < DM_TAG_ATTACH_COUNT; i++) {
+		if (dev_get_attach_ptr(dev, i))
+			mem += dev_get_attach_size(dev, i);
+	}
+#if IS_ENABLED(CONFIG_DEVRES)
+	{
+		struct devres_stats stats = { 0 };
+
+		devres_get_stats(dev, &stats);
+		mem += stats.total_size;
+	}
+#endif
+
+	return mem;
+}
+
+#if CONFIG_IS_ENABLED(DM_TIMING)
+/* Number of drivers added to bootstage by dm_timing_add_bootstage() */
+#define DM_TIMING_BOOTSTAGE_COUNT	8
+
+ulong dev_get_time_us(const struct udevice *dev)
+{
+	const struct udevice_timing *timing = &dev->timing;
+
+	return timing->bind_us + timing->of_to_plat_us + timing->pre_probe_us +
+		timing->probe_us + timing->post_probe_us;
+}
+
+static void dm_collect_driver_timing(const struct udevice *parent,
+				     struct dm_driver_timing *list, int *countp)
+{
+	struct dm_driver_timing *entry;
+	const struct udevice *dev;
+	int i;
+
+	for (i = 0, entry = list; i < *countp; i++, entry++) {
+		if (entry->drv == parent->driver)
+			break;
+	}
+	if (i == *countp) {
+		entry->drv = parent->driver;
+		(*countp)++;
+	}
+	entry->dev_count++;
+	entry->time_us += dev_get_time_us(parent);
+	entry->mem += dev_get_mem(parent);
+
+	list_for_each_entry(dev, &parent->child_head, sibling_node)
+		dm_collect_driver_timing(dev, list, countp);
+}
+
+static int h_cmp_driver_time(const void *v1, const void *v2)
+{
+	const struct dm_driver_timing *t1 = v1, *t2 = v2;
+
+	if (t1->time_us != t2->time_us)
+		return t1->time_us < t2->time_us ? 1 : -1;
+
+	return strcmp(t1->drv->name, t2->drv->name);
+}
+
+int dm_get_driver_timing(struct dm_driver_timing **listp)
+{
+	struct dm_driver_timing *list;
+	int count = 0;
+
+	/* There cannot be more drivers in use than there are devices */
+	list = calloc(device_get_decendent_count(gd->dm_root), sizeof(*list));
+	if (!list)
+		return -ENOMEM;
+	dm_collect_driver_timing(gd->dm_root, list, &count);
+	qsort(list, count, sizeof(*list), h_cmp_driver_time);
+	*listp = list;
+
+	return count;
+}
+
+void dm_timing_add_bootstage(void)
+{
+	struct dm_driver_timing *list;
+	int count, i;
+
+	if (!gd->dm_root)
+		return;
+	count = dm_get_driver_timing(&list);
+	if (count < 0)
+		return;
+	for (i = 0; i < count && i < DM_TIMING_BOOTSTAGE_COUNT; i++) {
+		if (!list[i].time_us)
+			break;
+		bootstage_add_accum(list[i].drv->name, list[i].time_us);
+	}
+	free(list);
+}
+#endif /* DM_TIMING */
+
 #if CONFIG_IS_ENABLED(ACPIGEN)
 static int root_acpi_get_name(const struct udevice *dev, char *out_name)
 {
@@ -17,6 +17,7 @@
 #include <dm/device-internal.h>
 #include <dm/lists.h>
 #include <dm/ofnode_graph.h>
+#include <dm/root.h>
 #include <dm/uclass.h>
 #include <dm/uclass-internal.h>
 #include <dm/util.h>
@@ -25,15 +26,16 @@ DECLARE_GLOBAL_DATA_PTR;
 
 struct uclass *uclass_find(enum uclass_id key)
 {
+	struct uclass **table = gd_uclass_table();
 	struct uclass *uc;
 
 	if (!gd->dm_root)
 		return NULL;
-	/*
-	 * TODO(sjg@chromium.org): Optimise this, perhaps moving the found
-	 * node to the start of the list, or creating a linear array mapping
-	 * id to node.
-	 */
+	if (table) {
+		if ((uint)key >= UCLASS_COUNT)
+			return NULL;
+		return table[key];
+	}
 	list_for_each_entry(uc, gd->uclass_root, sibling_node) {
 		if (uc->uc_drv->id == key)
 			return uc;
@@ -42,6 +44,20 @@ struct uclass *uclass_find(enum uclass_id key)
 	return NULL;
 }
 
+/**
+ * uclass_table_set() - Update the entry for a uclass in the uclass table
+ *
+ * @id: ID of uclass to update
+ * @uc: uclass to record, or NULL if it has been removed
+ */
+static void uclass_table_set(enum uclass_id id, struct uclass *uc)
+{
+	struct uclass **table = gd_uclass_table();
+
+	if (table && (uint)id < UCLASS_COUNT)
+		table[id] = uc;
+}
+
 /**
  * uclass_add() - Create new uclass in list
  * @id: Id number to create
@@ -86,6 +102,7 @@ static int uclass_add(enum uclass_id id, struct uclass **ucp)
 	INIT_LIST_HEAD(&uc->sibling_node);
 	INIT_LIST_HEAD(&uc->dev_head);
 	list_add(&uc->sibling_node, DM_UCLASS_ROOT_NON_CONST);
+	uclass_table_set(id, uc);
 
 	if (uc_drv->init) {
 		ret = uc_drv->init(uc);
@@ -102,6 +119,7 @@ fail:
 		uclass_set_priv(uc, NULL);
 	}
 	list_del(&uc->sibling_node);
+	uclass_table_set(id, NULL);
 fail_mem:
 	free(uc);
 
@@ -135,6 +153,7 @@ int uclass_destroy(struct uclass *uc)
 	if (uc_drv->destroy)
 		uc_drv->destroy(uc);
 	list_del(&uc->sibling_node);
+	uclass_table_set(uc_drv->id, NULL);
 	if (uc_drv->priv_auto)
 		free(uclass_get_priv(uc));
 	free(uc);
@@ -142,7 +161,7 @@ int uclass_destroy(struct uclass *uc)
 	return 0;
 }
 
-int uclass_get(enum uclass_id id, struct uclass **ucp)
+int uclass_get_nolazy(enum uclass_id id, struct uclass **ucp)
 {
 	struct uclass *uc;
 
@@ -161,6 +180,14 @@ int uclass_get(enum uclass_id id, struct uclass **ucp)
 	return 0;
 }
 
+int uclass_get(enum uclass_id id, struct uclass **ucp)
+{
+	if (CONFIG_IS_ENABLED(DM_LAZY_BIND) && gd_dm_lazy())
+		dm_lazy_bind_uclass(id);
+
+	return uclass_get_nolazy(id, ucp);
+}
+
 const char *uclass_get_name(enum uclass_id id)
 {
 	struct uclass *uc;
@@ -387,6 +414,28 @@ int uclass_find_device_by_of_offset(enum uclass_id id, int node,
 	return -ENODEV;
 }
 
+/**
+ * uclass_find_in_uc_by_ofnode() - Find the device in a uclass for a node
+ *
+ * @uc: uclass to search
+ * @node: Devicetree node to search for
+ * Return: device, or NULL if none
+ */
+static struct udevice *uclass_find_in_uc_by_ofnode(struct uclass *uc,
+						   ofnode node)
+{
+	struct udevice *dev;
+
+	uclass_foreach_dev(dev, uc) {
+		log(LOGC_DM, LOGL_DEBUG_CONTENT, "      - checking %s\n",
+		    dev->name);
+		if (ofnode_equal(dev_ofnode(dev), node))
+			return dev;
+	}
+
+	return NULL;
+}
+
 int uclass_find_device_by_ofnode(enum uclass_id id, ofnode node,
 				 struct udevice **devp)
 {
@@ -402,13 +451,16 @@ int uclass_find_device_by_ofnode(enum uclass_id id, ofnode node,
 	if (ret)
 		return ret;
 
-	uclass_foreach_dev(dev, uc) {
-		log(LOGC_DM, LOGL_DEBUG_CONTENT, "      - checking %s\n",
-		    dev->name);
-		if (ofnode_equal(dev_ofnode(dev), node)) {
-			*devp = dev;
-			goto done;
-		}
+	/*
+	 * The node, or the parent which binds it, may still be recorded for
+	 * lazy binding, e.g. if the device is bound by its parent's bind()
+	 */
+	dev = uclass_find_in_uc_by_ofnode(uc, node);
+	if (!dev && dm_lazy_bind_ofnode(node) > 0)
+		dev = uclass_find_in_uc_by_ofnode(uc, node);
+	if (dev) {
+		*devp = dev;
+		goto done;
 	}
 	ret = -ENODEV;
 
@@ -425,24 +477,29 @@ static int uclass_find_device_by_phandle_id(enum uclass_id id,
 {
 	struct udevice *dev;
 	struct uclass *uc;
+	ofnode node;
 	int ret;
 
 	ret = uclass_get(id, &uc);
 	if (ret)
 		return ret;
 
-	uclass_foreach_dev(dev, uc) {
-		uint phandle;
-
-		phandle = dev_read_phandle(dev);
+	/*
+	 * Find the node once and compare it against each device, rather than
+	 * reading the phandle property of every device in the uclass
+	 */
+	node = ofnode_get_by_phandle(find_phandle);
+	if (!ofnode_valid(node))
+		return -ENODEV;
 
-		if (phandle == find_phandle) {
-			*devp = dev;
-			return 0;
-		}
-	}
+	dev = uclass_find_in_uc_by_ofnode(uc, node);
+	if (!dev && dm_lazy_bind_ofnode(node) > 0)
+		dev = uclass_find_in_uc_by_ofnode(uc, node);
+	if (!dev)
+		return -ENODEV;
+	*devp = dev;
 
-	return -ENODEV;
+	return 0;
 }
 
 int uclass_find_device_by_phandle(enum uclass_id id, struct udevice *parent,
@@ -7,6 +7,9 @@
 #define LOG_CATEGORY UCLASS_HASH
 
 #include <dm.h>
+#include <hash.h>
+#include <log.h>
+#include <time.h>
 #include <asm/global_data.h>
 #include <u-boot/hash.h>
 #include <errno.h>
@@ -14,6 +17,12 @@
 #include <malloc.h>
 #include <asm/io.h>
 #include <linux/list.h>
+#include <linux/sizes.h>
+
+/* Input sizes tried by hash_measure_min_size(), going up by 4x each time */
+#define HASH_MEASURE_MIN	SZ_256
+#define HASH_MEASURE_MAX	SZ_64K
+#define HASH_MEASURE_LOOPS	4
 
 struct hash_info {
 	char *name;
@@ -114,7 +123,110 @@ int hash_finish(struct udevice *dev, void *ctx, void *obuf)
 	return ops->hash_finish(dev, ctx, obuf);
 }
 
+int hash_measure_min_size(struct udevice *dev, enum HASH_ALGO algo)
+{
+	struct hash_uc_plat *plat = dev_get_uclass_plat(dev);
+	ulong start, cpu_us, dev_us, size;
+	struct hash_algo *sw;
+	u8 out[64];
+	u8 *buf;
+	int i, ret;
+
+	/* With nothing to compare against, use the engine for any size */
+	ret = hash_lookup_algo(hash_algo_name(algo), &sw);
+	if (ret) {
+		plat->measured |= BIT(algo);
+		return 0;
+	}
+	buf = malloc(HASH_MEASURE_MAX);
+	if (!buf)
+		return log_msg_ret("buf", -ENOMEM);
+	memset(buf, 0xa5, HASH_MEASURE_MAX);
+
+	/* If the engine is never faster, or fails, leave it alone */
+	plat->measured |= BIT(algo);
+	plat->disabled |= BIT(algo);
+	for (size = HASH_MEASURE_MIN; size <= HASH_MEASURE_MAX; size *= 4) {
+		start = timer_get_us();
+		for (i = 0; i < HASH_MEASURE_LOOPS; i++)
+			sw->hash_func_ws(buf, size, out, size);
+		cpu_us = timer_get_us() - start;
+
+		start = timer_get_us();
+		for (i = 0; i < HASH_MEASURE_LOOPS; i++) {
+			ret = hash_digest(dev, algo, buf, size, out);
+			if (ret)
+				goto out;
+		}
+		dev_us = timer_get_us() - start;
+
+		if (dev_us < cpu_us) {
+			plat->min_size[algo] = size;
+			plat->disabled &= ~BIT(algo);
+			break;
+		}
+	}
+	if (plat->disabled & BIT(algo))
+		log_debug("%s: %s not faster than CPU\n", dev->name, sw->name);
+	else
+		log_debug("%s: %s from %lx bytes\n", dev->name, sw->name,
+			  plat->min_size[algo]);
+out:
+	free(buf);
+
+	return ret;
+}
+
+int hash_find_device(enum HASH_ALGO algo, ulong size, struct udevice **devp)
+{
+	struct hash_uc_plat *plat;
+	struct udevice *dev;
+
+	if (algo >= HASH_ALGO_NUM)
+		return -ENODEV;
+
+	uclass_foreach_dev_probe(UCLASS_HASH, dev) {
+		plat = dev_get_uclass_plat(dev);
+		if (plat->cpu || (plat->algos && !(plat->algos & BIT(algo))))
+			continue;
+		if (!(plat->measured & BIT(algo))) {
+			if (IS_ENABLED(CONFIG_DM_HASH_MEASURE))
+				hash_measure_min_size(dev, algo);
+			else
+				plat->measured |= BIT(algo);
+			/* Measuring may not be possible yet, e.g. no memory */
+			if (!(plat->measured & BIT(algo)))
+				continue;
+		}
+		if (plat->disabled & BIT(algo))
+			continue;
+		if (size >= plat->min_size[algo]) {
+			*devp = dev;
+			return 0;
+		}
+	}
+
+	return -ENODEV;
+}
+
+static int hash_post_bind(struct udevice *dev)
+{
+	struct hash_uc_plat *plat = dev_get_uclass_plat(dev);
+	u32 min_size;
+	int i;
+
+	if (!dev_read_u32(dev, "u-boot,hash-min-size", &min_size)) {
+		for (i = 0; i < HASH_ALGO_NUM; i++)
+			plat->min_size[i] = min_size;
+		plat->measured = GENMASK(HASH_ALGO_NUM - 1, 0);
+	}
+
+	return 0;
+}
+
 UCLASS_DRIVER(hash) = {
 	.id	= UCLASS_HASH,
 	.name	= "hash",
+	.post_bind	= hash_post_bind,
+	.per_device_plat_auto	= sizeof(struct hash_uc_plat),
 };
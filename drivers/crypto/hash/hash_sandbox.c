@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Sandbox hash engine
+ *
+ * This does the hashing on the CPU, like any other sandbox driver, but counts
+ * the operations it is given so that tests can see what is offloaded.
+ */
+
+#include <dm.h>
+#include <hash.h>
+#include <malloc.h>
+#include <asm/test.h>
+#include <linux/bitops.h>
+#include <u-boot/hash.h>
+
+/**
+ * struct sandbox_hash_priv - Private information about the engine
+ *
+ * @count: Number of hashes started
+ */
+struct sandbox_hash_priv {
+	int count;
+};
+
+/**
+ * struct sandbox_hash_ctx - Context for progressive hashing
+ *
+ * @algo: Software algorithm doing the work
+ * @ctx: Context for @algo
+ */
+struct sandbox_hash_ctx {
+	struct hash_algo *algo;
+	void *ctx;
+};
+
+static int sandbox_hash_lookup(struct udevice *dev, enum HASH_ALGO algo,
+			       struct hash_algo **algop)
+{
+	struct sandbox_hash_priv *priv = dev_get_priv(dev);
+	const char *name = hash_algo_name(algo);
+
+	if (!name || hash_lookup_algo(name, algop))
+		return -EPROTONOSUPPORT;
+	priv->count++;
+
+	return 0;
+}
+
+static int sandbox_hash_init(struct udevice *dev, enum HASH_ALGO algo,
+			     void **ctxp)
+{
+	struct sandbox_hash_ctx *ctx;
+	int ret;
+
+	ctx = malloc(sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+	ret = sandbox_hash_lookup(dev, algo, &ctx->algo);
+	if (!ret && ctx->algo->hash_init(ctx->algo, &ctx->ctx))
+		ret = -EIO;
+	if (ret) {
+		free(ctx);
+		return ret;
+	}
+	*ctxp = ctx;
+
+	return 0;
+}
+
+static int sandbox_hash_update(struct udevice *dev, void *vctx,
+			       const void *ibuf, const uint32_t ilen)
+{
+	struct sandbox_hash_ctx *ctx = vctx;
+
+	if (ctx->algo->hash_update(ctx->algo, ctx->ctx, ibuf, ilen, 0))
+		return -EIO;
+
+	return 0;
+}
+
+static int sandbox_hash_finish(struct udevice *dev, void *vctx, void *obuf)
+{
+	struct sandbox_hash_ctx *ctx = vctx;
+	int ret;
+
+	ret = ctx->algo->hash_finish(ctx->algo, ctx->ctx, obuf,
+				     ctx->algo->digest_size);
+	free(ctx);
+
+	return ret ? -EIO : 0;
+}
+
+static int sandbox_hash_digest_wd(struct udevice *dev, enum HASH_ALGO algo,
+				  const void *ibuf, const uint32_t ilen,
+				  void *obuf, uint32_t chunk_sz)
+{
+	struct hash_algo *sw;
+	int ret;
+
+	ret = sandbox_hash_lookup(dev, algo, &sw);
+	if (ret)
+		return ret;
+	sw->hash_func_ws(ibuf, ilen, obuf, chunk_sz);
+
+	return 0;
+}
+
+static int sandbox_hash_digest(struct udevice *dev, enum HASH_ALGO algo,
+			       const void *ibuf, const uint32_t ilen,
+			       void *obuf)
+{
+	return sandbox_hash_digest_wd(dev, algo, ibuf, ilen, obuf, ilen);
+}
+
+int sandbox_hash_get_count(struct udevice *dev)
+{
+	struct sandbox_hash_priv *priv = dev_get_priv(dev);
+
+	return priv->count;
+}
+
+static int sandbox_hash_bind(struct udevice *dev)
+{
+	struct hash_uc_plat *plat = dev_get_uclass_plat(dev);
+
+	/* Like a typical engine, this only offers the SHA family */
+	plat->algos = BIT(HASH_ALGO_SHA1) | BIT(HASH_ALGO_SHA256) |
+		BIT(HASH_ALGO_SHA384) | BIT(HASH_ALGO_SHA512);
+
+	return 0;
+}
+
+static const struct hash_ops sandbox_hash_ops = {
+	.hash_init	= sandbox_hash_init,
+	.hash_update	= sandbox_hash_update,
+	.hash_finish	= sandbox_hash_finish,
+	.hash_digest	= sandbox_hash_digest,
+	.hash_digest_wd	= sandbox_hash_digest_wd,
+};
+
+static const struct udevice_id sandbox_hash_ids[] = {
+	{ .compatible = "sandbox,hash" },
+	{ }
+};
+
+U_BOOT_DRIVER(sandbox_hash) = {
+	.name	= "sandbox_hash",
+	.id	= UCLASS_HASH,
+	.of_match = sandbox_hash_ids,
+	.bind	= sandbox_hash_bind,
+	.ops	= &sandbox_hash_ops,
+	.priv_auto	= sizeof(struct sandbox_hash_priv),
+};
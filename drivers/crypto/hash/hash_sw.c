@@ -280,6 +280,16 @@ static int sw_hash_digest(struct udevice *dev, enum HASH_ALGO algo,
 	return sw_hash_digest_wd(dev, algo, ibuf, ilen, obuf, ilen);
 }
 
+static int sw_hash_bind(struct udevice *dev)
+{
+	struct hash_uc_plat *plat = dev_get_uclass_plat(dev);
+
+	/* This is the CPU, so hash_find_device() must not pick it */
+	plat->cpu = true;
+
+	return 0;
+}
+
 static const struct hash_ops hash_ops_sw = {
 	.hash_init = sw_hash_init,
 	.hash_update = sw_hash_update,
@@ -292,6 +302,7 @@ U_BOOT_DRIVER(hash_sw) = {
 	.name = "hash_sw",
 	.id = UCLASS_HASH,
 	.ops = &hash_ops_sw,
+	.bind = sw_hash_bind,
 	.flags = DM_FLAG_PRE_RELOC,
 };
 
@@ -385,7 +385,11 @@ void mmc_do_preinit(void)
 
 		m->user_speed_mode = MMC_MODES_END;  /* Initialising user set speed mode */
 
-		if (m->preinit)
+		if (!m->preinit)
+			continue;
+		if (CONFIG_IS_ENABLED(MMC_ASYNC_INIT))
+			mmc_start_init_async(m);
+		else
 			mmc_start_init(m);
 	}
 }
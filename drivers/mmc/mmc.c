@@ -779,6 +779,10 @@ static int mmc_send_op_cond(struct mmc *mmc)
 		if (mmc->ocr & OCR_BUSY)
 			break;
 
+		/* Leave the busy-poll to mmc_cyclic_init_poll() */
+		if (mmc->init_async && i)
+			break;
+
 		if (get_timer(start) > timeout)
 			return -ETIMEDOUT;
 		udelay(100);
@@ -796,8 +800,12 @@ static int mmc_complete_op_cond(struct mmc *mmc)
 
 	mmc->op_cond_pending = 0;
 	if (!(mmc->ocr & OCR_BUSY)) {
-		/* Some cards seem to need this */
-		mmc_go_idle(mmc);
+		/*
+		 * Some cards seem to need this, but do not reset a card which
+		 * is still powering up after an asynchronous start
+		 */
+		if (!mmc->init_async)
+			mmc_go_idle(mmc);
 
 		start = get_timer(0);
 		while (1) {
@@ -3082,7 +3090,11 @@ int mmc_start_init(struct mmc *mmc)
 	if (no_card) {
 		mmc->has_init = 0;
 #if !defined(CONFIG_XPL_BUILD) || defined(CONFIG_SPL_LIBCOMMON_SUPPORT)
-		log_err("MMC: no card present\n");
+		/* mmc_init() reports this if the card is actually used */
+		if (mmc->init_async)
+			log_debug("MMC: no card present\n");
+		else
+			log_err("MMC: no card present\n");
 #endif
 		return -ENOMEDIUM;
 	}
@@ -3102,6 +3114,7 @@ static int mmc_complete_init(struct mmc *mmc)
 	mmc->init_in_progress = 0;
 	if (mmc->op_cond_pending)
 		err = mmc_complete_op_cond(mmc);
+	mmc->init_async = 0;
 
 	if (!err)
 		err = mmc_startup(mmc);
@@ -3126,6 +3139,42 @@ static void mmc_cyclic_cd_poll(struct cyclic_info *c)
 	m->has_init = 0;
 }
 
+#if CONFIG_IS_ENABLED(MMC_ASYNC_INIT)
+static void mmc_cyclic_init_poll(struct cyclic_info *c)
+{
+	struct mmc *m = container_of(c, struct mmc, init_cyclic);
+
+	/*
+	 * Stop polling once the card is ready, or on error / timeout, in
+	 * which case mmc_complete_init() retries and reports the failure
+	 */
+	if (!m->op_cond_pending || mmc_send_op_cond_iter(m, 1) ||
+	    (m->ocr & OCR_BUSY) ||
+	    get_timer_us(0) - c->start_time_us > 1000 * 1000)
+		cyclic_unregister(c);
+}
+
+int mmc_start_init_async(struct mmc *mmc)
+{
+	int err;
+
+	if (mmc->has_init || mmc->init_in_progress)
+		return 0;
+
+	mmc->init_async = 1;
+	err = mmc_start_init(mmc);
+	if (err || !mmc->op_cond_pending || (mmc->ocr & OCR_BUSY)) {
+		mmc->init_async = 0;
+		return err;
+	}
+
+	cyclic_register(&mmc->init_cyclic, mmc_cyclic_init_poll, 1000,
+			mmc->cfg->name);
+
+	return 0;
+}
+#endif
+
 int mmc_init(struct mmc *mmc)
 {
 	int err = 0;
@@ -3140,6 +3189,10 @@ int mmc_init(struct mmc *mmc)
 
 	start = get_timer(0);
 
+	/* Any background polling must stop before the card is used here */
+	if (CONFIG_IS_ENABLED(MMC_ASYNC_INIT))
+		cyclic_unregister(&mmc->init_cyclic);
+
 	if (!mmc->init_in_progress)
 		err = mmc_start_init(mmc);
 
@@ -3166,6 +3219,10 @@ int mmc_deinit(struct mmc *mmc)
 	if (CONFIG_IS_ENABLED(CYCLIC, (mmc->cyclic.func), (NULL)))
 		cyclic_unregister(&mmc->cyclic);
 
+	/* Do not leave a background op_cond poll running on a stopped device */
+	if (CONFIG_IS_ENABLED(MMC_ASYNC_INIT))
+		cyclic_unregister(&mmc->init_cyclic);
+
 	if (!CONFIG_IS_ENABLED(MMC_UHS_SUPPORT) &&
 	    !CONFIG_IS_ENABLED(MMC_HS200_SUPPORT) &&
 	    !CONFIG_IS_ENABLED(MMC_HS400_SUPPORT))
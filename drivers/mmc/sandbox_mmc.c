@@ -30,13 +30,16 @@ struct sandbox_mmc_priv {
 	char *buf;
 	int csize;	/* CSIZE value to report */
 	int size;
+	bool emmc;	/* emulate an eMMC rather than an SD card */
+	int busy_polls;	/* CMD1 polls before the eMMC reports ready */
 };
 
 /**
  * sandbox_mmc_send_cmd() - Emulate SD commands
  *
  * This emulate an SD card version 2. Single-block reads result in zero data.
- * Multiple-block reads return a test string.
+ * Multiple-block reads return a test string. With sandbox_mmc_set_emmc() it
+ * instead emulates an eMMC version 1.2 which is slow to power up.
  */
 static int sandbox_mmc_send_cmd(struct udevice *dev, struct mmc_cmd *cmd,
 				struct mmc_data *data)
@@ -44,6 +47,21 @@ static int sandbox_mmc_send_cmd(struct udevice *dev, struct mmc_cmd *cmd,
 	struct sandbox_mmc_priv *priv = dev_get_priv(dev);
 	static ulong erase_start, erase_end;
 
+	if (priv->emmc) {
+		switch (cmd->cmdidx) {
+		case SD_CMD_SEND_IF_COND:
+		case MMC_CMD_APP_CMD:
+			return -ETIMEDOUT;
+		case MMC_CMD_SEND_OP_COND:
+			cmd->response[0] = OCR_HCS;
+			if (priv->busy_polls)
+				priv->busy_polls--;
+			else
+				cmd->response[0] |= OCR_BUSY;
+			return 0;
+		}
+	}
+
 	switch (cmd->cmdidx) {
 	case MMC_CMD_ALL_SEND_CID:
 		memset(cmd->response, '\0', sizeof(cmd->response));
@@ -65,7 +83,8 @@ static int sandbox_mmc_send_cmd(struct udevice *dev, struct mmc_cmd *cmd,
 		cmd->response[1] = (MMC_BL_LEN_SHIFT << 16) |
 				   ((priv->csize >> 16) & 0x3f);
 		cmd->response[2] = (priv->csize & 0xffff) << 16;
-		cmd->response[3] = 0;
+		/* WRITE_BL_LEN is only used by MMC */
+		cmd->response[3] = priv->emmc ? 9 << 22 : 0;
 		break;
 	case SD_CMD_SWITCH_FUNC: {
 		if (!data)
@@ -138,6 +157,14 @@ static int sandbox_mmc_get_cd(struct udevice *dev)
 	return 1;
 }
 
+void sandbox_mmc_set_emmc(struct udevice *dev, int busy_polls)
+{
+	struct sandbox_mmc_priv *priv = dev_get_priv(dev);
+
+	priv->emmc = true;
+	priv->busy_polls = busy_polls;
+}
+
 static const struct dm_mmc_ops sandbox_mmc_ops = {
 	.send_cmd = sandbox_mmc_send_cmd,
 	.set_ios = sandbox_mmc_set_ios,
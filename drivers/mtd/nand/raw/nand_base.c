@@ -1121,6 +1121,31 @@ int nand_read_page_op(struct nand_chip *chip, unsigned int page,
 }
 EXPORT_SYMBOL_GPL(nand_read_page_op);
 
+/**
+ * nand_read_cache_seq_op - Do a READ CACHE SEQUENTIAL or READ CACHE END
+ *			    operation
+ * @chip: The NAND chip
+ * @last: true to end the sequence after this page
+ *
+ * This function moves the page being loaded by the previous READ PAGE or
+ * READ CACHE SEQUENTIAL operation to the cache register, from which it can be
+ * read out with the page accessors. Unless @last is set, the chip then starts
+ * loading the following page in the background, so the array access overlaps
+ * with the transfer and ECC correction of the current page.
+ * This function does not select/unselect the CS line.
+ *
+ * Returns 0 on success, a negative error code otherwise.
+ */
+static int nand_read_cache_seq_op(struct nand_chip *chip, bool last)
+{
+	struct mtd_info *mtd = nand_to_mtd(chip);
+
+	chip->cmdfunc(mtd, last ? NAND_CMD_READCACHEEND : NAND_CMD_READCACHESEQ,
+		      -1, -1);
+
+	return 0;
+}
+
 /**
  * nand_read_param_page_op - Do a READ PARAMETER PAGE operation
  * @chip: The NAND chip
@@ -2321,12 +2346,14 @@ static int nand_do_read_ops(struct mtd_info *mtd, loff_t from,
 	uint32_t readlen = ops->len;
 	uint32_t oobreadlen = ops->ooblen;
 	uint32_t max_oobsize = mtd_oobavail(mtd, ops);
+	int ppb_mask = (1 << (chip->phys_erase_shift - chip->page_shift)) - 1;
 
 	uint8_t *bufpoi, *oob, *buf;
 	int use_bufpoi;
 	unsigned int max_bitflips = 0;
 	int retry_mode = 0;
 	bool ecc_fail = false;
+	bool cache_read = false, cache_next;
 
 	chipnr = (int)(from >> chip->chip_shift);
 	chip->select_chip(mtd, chipnr);
@@ -2355,8 +2382,21 @@ static int nand_do_read_ops(struct mtd_info *mtd, loff_t from,
 		else
 			use_bufpoi = 0;
 
-		/* Is the current page in the buffer? */
-		if (realpage != chip->pagebuf || oob) {
+		/*
+		 * Let the chip load the next page while this one is transferred
+		 * and corrected, as long as whole pages of the same block are
+		 * read.
+		 */
+		cache_next = NAND_HAS_READ_CACHE(chip) && aligned && !oob &&
+			     ops->mode != MTD_OPS_RAW && !retry_mode &&
+			     readlen - bytes >= mtd->writesize &&
+			     ((realpage + 1) & ppb_mask);
+
+		/*
+		 * Is the current page in the buffer? A page already being
+		 * loaded by a cache read must be read out anyway.
+		 */
+		if (realpage != chip->pagebuf || oob || cache_read) {
 			bufpoi = use_bufpoi ? chip->buffers->databuf : buf;
 
 			if (use_bufpoi && aligned)
@@ -2365,9 +2405,20 @@ static int nand_do_read_ops(struct mtd_info *mtd, loff_t from,
 
 read_retry:
 			if (nand_standard_page_accessors(&chip->ecc)) {
-				ret = nand_read_page_op(chip, page, 0, NULL, 0);
+				if (cache_read)
+					ret = nand_read_cache_seq_op(chip,
+								     !cache_next);
+				else if (cache_next)
+					ret = nand_read_page_op(chip, page, 0,
+								NULL, 0) ?:
+					      nand_read_cache_seq_op(chip,
+								     false);
+				else
+					ret = nand_read_page_op(chip, page, 0,
+								NULL, 0);
 				if (ret)
 					break;
+				cache_read = cache_next;
 			}
 
 			/*
@@ -2429,6 +2480,22 @@ read_retry:
 
 			if (mtd->ecc_stats.failed - ecc_failures) {
 				if (retry_mode + 1 < chip->read_retries) {
+					/*
+					 * End any cache read, and let the chip
+					 * finish loading the next page, before
+					 * changing the retry mode. Then re-read
+					 * this page outside of a cache read.
+					 */
+					if (cache_read) {
+						nand_read_cache_seq_op(chip, true);
+						if (!chip->dev_ready)
+							udelay(chip->chip_delay);
+						else
+							nand_wait_ready(mtd);
+						cache_read = false;
+					}
+					cache_next = false;
+
 					retry_mode++;
 					ret = nand_setup_read_retry(mtd,
 							retry_mode);
@@ -2478,6 +2545,11 @@ read_retry:
 			chip->select_chip(mtd, chipnr);
 		}
 	}
+
+	/* Do not leave the chip in the middle of a cache read on error */
+	if (cache_read)
+		nand_read_cache_seq_op(chip, true);
+
 	chip->select_chip(mtd, -1);
 
 	ops->retlen = ops->len - (size_t) readlen;
@@ -3949,6 +4021,9 @@ static int nand_flash_detect_onfi(struct mtd_info *mtd, struct nand_chip *chip)
 	if (onfi_feature(chip) & ONFI_FEATURE_16_BIT_BUS)
 		chip->options |= NAND_BUSWIDTH_16;
 
+	if (le16_to_cpu(p->opt_cmd) & ONFI_OPT_CMD_READ_CACHE)
+		chip->options |= NAND_READ_CACHE;
+
 	if (p->ecc_bits != 0xff) {
 		chip->ecc_strength_ds = p->ecc_bits;
 		chip->ecc_step_ds = 512;
@@ -5172,6 +5247,20 @@ int nand_scan_tail(struct mtd_info *mtd)
 	/* Invalidate the pagebuffer reference */
 	chip->pagebuf = -1;
 
+	/*
+	 * Sequential cache reads are issued between the page accessors, which
+	 * have to leave the command sequence to the core, and through cmdfunc,
+	 * which has to know about the cache read commands.
+	 * NAND_ECC_HW_OOB_FIRST reads the OOB area with its own READOOB/READ0
+	 * commands inside read_page, which would break the cache sequence.
+	 */
+	if (!nand_standard_page_accessors(ecc) ||
+	    ecc->mode == NAND_ECC_HW_OOB_FIRST ||
+	    chip->options & NAND_NEED_READRDY ||
+	    (chip->cmdfunc != nand_command_lp &&
+	     !(chip->options & NAND_CMDFUNC_READ_CACHE)))
+		chip->options &= ~NAND_READ_CACHE;
+
 	/* Large page NAND with SOFT_ECC should support subpage reads */
 	switch (ecc->mode) {
 	case NAND_ECC_SOFT:
@@ -22,6 +22,7 @@
  * this file might be covered by the GNU General Public License.
  */
 
+#include <asm/unaligned.h>
 #include <linux/errno.h>
 #include <linux/mtd/mtd.h>
 #include <linux/mtd/nand_ecc.h>
@@ -54,34 +55,78 @@ static const u_char nand_ecc_precalc_table[] = {
 	0x00, 0x55, 0x56, 0x03, 0x59, 0x0c, 0x0f, 0x5a, 0x5a, 0x0f, 0x0c, 0x59, 0x03, 0x56, 0x55, 0x00
 };
 
+/* Parity of a 32-bit word, using the parity bit of the table above */
+static inline uint8_t nand_ecc_parity32(uint32_t w)
+{
+	w ^= w >> 16;
+	w ^= w >> 8;
+
+	return (nand_ecc_precalc_table[w & 0xff] >> 6) & 1;
+}
+
 /**
  * nand_calculate_ecc - [NAND Interface] Calculate 3-byte ECC for 256-byte block
  * @mtd:	MTD block structure
  * @dat:	raw data
  * @ecc_code:	buffer for ECC
+ *
+ * The column parities are linear in the data, so they are looked up once for
+ * the XOR of all bytes. Bit k of the line parity is the parity of all bytes
+ * whose index has bit k set. The data is processed 32 bits at a time, in
+ * groups of eight words: the two low index bits select bytes within a word,
+ * the next three select a word within a group and the top three a group.
  */
 int nand_calculate_ecc(struct mtd_info *mtd, const u_char *dat,
 		       u_char *ecc_code)
 {
 	uint8_t idx, reg1, reg2, reg3, tmp1, tmp2;
-	int i;
-
-	/* Initialize variables */
-	reg1 = reg2 = reg3 = 0;
-
-	/* Build up column parity */
-	for(i = 0; i < 256; i++) {
-		/* Get CP0 - CP5 from table */
-		idx = nand_ecc_precalc_table[*dat++];
-		reg1 ^= (idx & 0x3f);
-
-		/* All bit XOR = 1 ? */
-		if (idx & 0x40) {
-			reg3 ^= (uint8_t) i;
-			reg2 ^= ~((uint8_t) i);
-		}
+	uint32_t w0, w1, w2, w3, w4, w5, w6, w7, t01, t23, t45, t67, grp;
+	uint32_t all = 0, lines[6] = { 0 };
+	uint32_t w;
+	int i, j;
+
+	for (i = 0; i < 8; i++, dat += 32) {
+		w0 = get_unaligned_le32(dat);
+		w1 = get_unaligned_le32(dat + 4);
+		w2 = get_unaligned_le32(dat + 8);
+		w3 = get_unaligned_le32(dat + 12);
+		w4 = get_unaligned_le32(dat + 16);
+		w5 = get_unaligned_le32(dat + 20);
+		w6 = get_unaligned_le32(dat + 24);
+		w7 = get_unaligned_le32(dat + 28);
+
+		t01 = w0 ^ w1;
+		t23 = w2 ^ w3;
+		t45 = w4 ^ w5;
+		t67 = w6 ^ w7;
+		grp = t01 ^ t23 ^ t45 ^ t67;
+
+		lines[0] ^= w1 ^ w3 ^ w5 ^ w7;
+		lines[1] ^= t23 ^ t67;
+		lines[2] ^= t45 ^ t67;
+		if (i & 1)
+			lines[3] ^= grp;
+		if (i & 2)
+			lines[4] ^= grp;
+		if (i & 4)
+			lines[5] ^= grp;
+		all ^= grp;
 	}
 
+	/* Get CP0 - CP5 and the overall parity from the table */
+	w = all ^ (all >> 16);
+	idx = nand_ecc_precalc_table[(w ^ (w >> 8)) & 0xff];
+	reg1 = idx & 0x3f;
+
+	/* Build up line parity, bytes 1 and 3, then 2 and 3 of each word */
+	reg3 = nand_ecc_parity32(all & 0xff00ff00);
+	reg3 |= nand_ecc_parity32(all & 0xffff0000) << 1;
+	for (j = 0; j < 6; j++)
+		reg3 |= nand_ecc_parity32(lines[j]) << (j + 2);
+
+	/* reg2 is the XOR of the inverted indexes of all odd parity bytes */
+	reg2 = idx & 0x40 ? ~reg3 : reg3;
+
 	/* Create non-inverted ECC code from line parity */
 	tmp1  = (reg3 & 0x80) >> 0; /* B7 -> B7 */
 	tmp1 |= (reg2 & 0x80) >> 1; /* B7 -> B6 */
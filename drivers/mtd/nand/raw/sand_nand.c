@@ -64,6 +64,8 @@ static const char *const state_name[] = {
  * @state: Current state of the device
  * @column: Column of the most-recent command
  * @page_addr: Page address of the most-recent command
+ * @cache_page_addr: Page to be read out by the next NAND_CMD_READCACHESEQ or
+ *                   NAND_CMD_READCACHEEND, or -1 if no page is loaded
  * @fd: File descriptor for the backing data
  * @fd_page_addr: Page address that @fd is seek'd to
  * @selected: Whether this device is selected
@@ -83,7 +85,7 @@ struct sand_nand_chip {
 	u32 err_count, err_step_bits, err_steps, ecc_bits;
 	unsigned int cs;
 	enum sand_nand_state state;
-	int column, page_addr, fd, fd_page_addr;
+	int column, page_addr, cache_page_addr, fd, fd_page_addr;
 	bool selected, tmp_dirty;
 	u8 status;
 	u8 id_len;
@@ -283,6 +285,7 @@ static void sand_nand_command(struct mtd_info *mtd, unsigned int command,
 			fallthrough;
 		case NAND_CMD_READ0:
 			new_state = STATE_IDLE;
+			chip->cache_page_addr = -1;
 			if (page_addr < 0 || page_addr >= chip->pages)
 				break;
 
@@ -293,6 +296,25 @@ static void sand_nand_command(struct mtd_info *mtd, unsigned int command,
 				break;
 
 			chip->page_addr = page_addr;
+			chip->cache_page_addr = page_addr;
+			new_state = STATE_READ;
+			break;
+		case NAND_CMD_READCACHESEQ:
+		case NAND_CMD_READCACHEEND:
+			new_state = STATE_IDLE;
+			if (chip->cache_page_addr < 0 ||
+			    chip->cache_page_addr >= chip->pages)
+				break;
+
+			chip->column = 0;
+			chip->page_addr = chip->cache_page_addr;
+			if (sand_nand_read(chip))
+				break;
+
+			if (command == NAND_CMD_READCACHESEQ)
+				chip->cache_page_addr++;
+			else
+				chip->cache_page_addr = -1;
 			new_state = STATE_READ;
 			break;
 		case NAND_CMD_ERASE1:
@@ -333,6 +355,7 @@ reset:
 			new_state = STATE_IDLE;
 			chip->column = -1;
 			chip->page_addr = -1;
+			chip->cache_page_addr = -1;
 			chip->status = ~NAND_STATUS_FAIL;
 			break;
 		default:
@@ -570,6 +593,7 @@ static int sand_nand_probe(struct udevice *dev)
 		chip->pagesize = pagesize;
 		chip->pages = pages;
 		chip->pages_per_erase = erasesize / pagesize;
+		chip->cache_page_addr = -1;
 		memset(chip->tmp, 0xff, chip->chunksize);
 
 		chip->err_count = err_count;
@@ -602,6 +626,7 @@ static int sand_nand_probe(struct udevice *dev)
 
 		nand = &chip->nand;
 		nand->options = not_xpl() ? 0 : NAND_SKIP_BBTSCAN;
+		nand->options |= NAND_CMDFUNC_READ_CACHE;
 		nand->flash_node = np;
 		nand->dev_ready = sand_nand_dev_ready;
 		nand->cmdfunc = sand_nand_command;
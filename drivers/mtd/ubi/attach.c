@@ -1243,6 +1243,20 @@ static int scan_all(struct ubi_device *ubi, struct ubi_attach_info *ai,
 	if (!vidh)
 		goto out_ech;
 
+	/*
+	 * If both headers fit in the first min. I/O unit, read them with a
+	 * single operation per PEB. This is only an optimization, so carry on
+	 * without it if the buffer cannot be allocated.
+	 */
+	if (ubi->vid_hdr_aloffset + ubi->vid_hdr_alsize <= ubi->min_io_size) {
+		int step = ubi->mtd->ecc_step_size ?: ubi->min_io_size;
+
+		ubi->hdrs_buf = kmalloc(ubi->min_io_size, GFP_KERNEL);
+		ubi->hdrs_pnum = -1;
+		ubi->hdrs_one_step = ubi->vid_hdr_aloffset + ubi->vid_hdr_alsize <=
+				     step;
+	}
+
 	for (pnum = start; pnum < ubi->peb_count; pnum++) {
 		cond_resched();
 
@@ -1252,6 +1266,9 @@ static int scan_all(struct ubi_device *ubi, struct ubi_attach_info *ai,
 			goto out_vidh;
 	}
 
+	kfree(ubi->hdrs_buf);
+	ubi->hdrs_buf = NULL;
+
 	ubi_msg(ubi, "scanning is finished");
 
 	/* Calculate mean erase counter */
@@ -1295,6 +1312,8 @@ static int scan_all(struct ubi_device *ubi, struct ubi_attach_info *ai,
 	return 0;
 
 out_vidh:
+	kfree(ubi->hdrs_buf);
+	ubi->hdrs_buf = NULL;
 	ubi_free_vid_hdr(ubi, vidh);
 out_ech:
 	kfree(ech);
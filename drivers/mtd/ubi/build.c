@@ -31,6 +31,7 @@
 #include <linux/slab.h>
 #include <linux/major.h>
 #else
+#include <time.h>
 #include <linux/bug.h>
 #include <linux/log2.h>
 #include <linux/printk.h>
@@ -876,6 +877,9 @@ int ubi_attach_mtd_dev(struct mtd_info *mtd, int ubi_num,
 {
 	struct ubi_device *ubi;
 	int i, err, ref = 0;
+#ifdef __UBOOT__
+	ulong start;
+#endif
 
 	if (max_beb_per1024 < 0 || max_beb_per1024 > MAX_MTD_UBI_BEB_LIMIT)
 		return -EINVAL;
@@ -996,6 +1000,9 @@ int ubi_attach_mtd_dev(struct mtd_info *mtd, int ubi_num,
 	ubi->fm_buf = vzalloc(ubi->fm_size);
 	if (!ubi->fm_buf)
 		goto out_free;
+#endif
+#ifdef __UBOOT__
+	start = get_timer(0);
 #endif
 	err = ubi_attach(ubi, 0);
 	if (err) {
@@ -1003,6 +1010,10 @@ int ubi_attach_mtd_dev(struct mtd_info *mtd, int ubi_num,
 			mtd->index, err);
 		goto out_free;
 	}
+#ifdef __UBOOT__
+	ubi_msg(ubi, "attached by %s in %lu ms", ubi->fm ? "fastmap" : "scanning",
+		get_timer(start));
+#endif
 
 	if (ubi->autoresize_vol_id != -1) {
 		err = autoresize(ubi, ubi->autoresize_vol_id);
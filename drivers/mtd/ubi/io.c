@@ -697,6 +697,53 @@ bad:
 	return 1;
 }
 
+/**
+ * read_hdr - read (part of) a header area of a physical eraseblock.
+ * @ubi: UBI device description object
+ * @buf: buffer where to store the read data
+ * @pnum: physical eraseblock number to read from
+ * @offset: offset within the physical eraseblock from where to read
+ * @len: how many bytes to read
+ *
+ * While attaching by scanning, @ubi->hdrs_buf is set up when the EC and VID
+ * headers live in the same min. I/O unit. Both headers are then fetched with
+ * one read, which the EC and VID header readers share, instead of reading
+ * the same NAND page twice.
+ *
+ * The bit-flip and ECC status of that read only applies to both headers if
+ * they are covered by the same ECC step. With sub-page ECC (e.g. the VID
+ * header in the second 512-byte step of the page) it may come from the other
+ * header, so in that case a read which did not succeed cleanly is repeated
+ * for the requested area alone, to get the status of that header. Other
+ * errors also fall back to a plain read of the requested area. Returns the
+ * same codes as 'ubi_io_read()'.
+ */
+static int read_hdr(struct ubi_device *ubi, void *buf, int pnum, int offset,
+		    int len)
+{
+	int err;
+
+	if (!ubi->hdrs_buf)
+		return ubi_io_read(ubi, buf, pnum, offset, len);
+
+	if (ubi->hdrs_pnum != pnum) {
+		err = ubi_io_read(ubi, ubi->hdrs_buf, pnum, 0,
+				  ubi->vid_hdr_aloffset + ubi->vid_hdr_alsize);
+		if (err && err != UBI_IO_BITFLIPS && !mtd_is_eccerr(err)) {
+			ubi->hdrs_pnum = -1;
+			return ubi_io_read(ubi, buf, pnum, offset, len);
+		}
+		ubi->hdrs_pnum = pnum;
+		ubi->hdrs_err = err;
+	}
+
+	if (ubi->hdrs_err && !ubi->hdrs_one_step)
+		return ubi_io_read(ubi, buf, pnum, offset, len);
+
+	memcpy(buf, ubi->hdrs_buf + offset, len);
+	return ubi->hdrs_err;
+}
+
 /**
  * ubi_io_read_ec_hdr - read and check an erase counter header.
  * @ubi: UBI device description object
@@ -728,7 +775,7 @@ int ubi_io_read_ec_hdr(struct ubi_device *ubi, int pnum,
 	dbg_io("read EC header from PEB %d", pnum);
 	ubi_assert(pnum >= 0 && pnum < ubi->peb_count);
 
-	read_err = ubi_io_read(ubi, ec_hdr, pnum, 0, UBI_EC_HDR_SIZE);
+	read_err = read_hdr(ubi, ec_hdr, pnum, 0, UBI_EC_HDR_SIZE);
 	if (read_err) {
 		if (read_err != UBI_IO_BITFLIPS && !mtd_is_eccerr(read_err))
 			return read_err;
@@ -998,8 +1045,8 @@ int ubi_io_read_vid_hdr(struct ubi_device *ubi, int pnum,
 	ubi_assert(pnum >= 0 &&  pnum < ubi->peb_count);
 
 	p = (char *)vid_hdr - ubi->vid_hdr_shift;
-	read_err = ubi_io_read(ubi, p, pnum, ubi->vid_hdr_aloffset,
-			  ubi->vid_hdr_alsize);
+	read_err = read_hdr(ubi, p, pnum, ubi->vid_hdr_aloffset,
+			    ubi->vid_hdr_alsize);
 	if (read_err && read_err != UBI_IO_BITFLIPS && !mtd_is_eccerr(read_err))
 		return read_err;
 
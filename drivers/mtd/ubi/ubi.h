@@ -527,6 +527,12 @@ struct ubi_debug_info {
  *
  * @peb_buf: a buffer of PEB size used for different purposes
  * @buf_mutex: protects @peb_buf
+ * @hdrs_buf: buffer used while scanning to read the EC and VID headers of a
+ *            PEB with a single I/O operation, %NULL if not in use
+ * @hdrs_pnum: PEB whose headers are held in @hdrs_buf, %-1 if none
+ * @hdrs_err: result of the read which filled @hdrs_buf
+ * @hdrs_one_step: both headers are covered by the same ECC step, so that
+ *                 @hdrs_err applies to each of them
  * @ckvol_mutex: serializes static volume checking when opening
  *
  * @dbg: debugging information for this UBI device
@@ -626,6 +632,10 @@ struct ubi_device {
 
 	void *peb_buf;
 	struct mutex buf_mutex;
+	void *hdrs_buf;
+	int hdrs_pnum;
+	int hdrs_err;
+	bool hdrs_one_step;
 	struct mutex ckvol_mutex;
 
 	struct ubi_debug_info dbg;
@@ -596,7 +596,7 @@ static int pcie_dw_imx_of_to_plat(struct udevice *dev)
 	if (info->flags & IMX_PCIE_FLAG_HAS_SERDES) {
 		void __iomem *app_base;
 		fdt_size_t app_size;
-		struct regmap_config config;
+		struct regmap_config config = {};
 
 		app_base = (void *)dev_read_addr_size_name(dev, "app", &app_size);
 		if ((fdt_addr_t)app_base == FDT_ADDR_T_NONE) {
@@ -652,7 +652,7 @@ static struct regmap *cdns_regmap_init(struct udevice *dev, void __iomem *base,
 				       u8 reg_offset_shift)
 {
 	struct cdns_sierra_phy *sp = dev_get_priv(dev);
-	struct regmap_config config;
+	struct regmap_config config = {};
 
 	config.r_start = (ulong)(base + (block_offset << block_offset_shift));
 	config.r_size = sp->size - (block_offset << block_offset_shift);
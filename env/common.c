@@ -436,6 +436,193 @@ int env_set_default_vars(int nvars, char * const vars[], int flags)
 				flags, 0, nvars, vars);
 }
 
+#if CONFIG_IS_ENABLED(ENV_SAVE_INCREMENTAL)
+#define ENV_REGION_SIZE		512
+#define ENV_REGIONS		DIV_ROUND_UP(CONFIG_ENV_SIZE, ENV_REGION_SIZE)
+
+/**
+ * struct env_image - The environment as last loaded or exported
+ *
+ * The environment is split into regions of ENV_REGION_SIZE bytes, counting
+ * from the start of the env_t, so that the CRC can be worked out again from
+ * the first region which changed and drivers can tell which regions to write.
+ *
+ * @env: Copy of the environment, or NULL if not allocated yet
+ * @valid: true if @env and @crc are set up
+ * @current: true if @env holds the export of the hash table, as it was when
+ *	hclean_r() was last called
+ * @stored: true if @env is known to be what the storage holds
+ * @crc: CRC32 of the data before each region, then of all the data
+ * @changed: Bitmap of regions which differ from the storage
+ */
+static struct env_image {
+	env_t *env;
+	bool valid;
+	bool current;
+	bool stored;
+	u32 crc[ENV_REGIONS + 1];
+	ulong changed[BITS_TO_LONGS(ENV_REGIONS)];
+} env_image;
+
+/* Get the offset into the environment data at which a region starts */
+static ulong env_region_data(int region)
+{
+	ulong start = region * ENV_REGION_SIZE;
+
+	if (start < ENV_HEADER_SIZE)
+		return 0;
+
+	return min_t(ulong, start - ENV_HEADER_SIZE, ENV_SIZE);
+}
+
+/**
+ * env_image_update() - Copy the data of an environment into the image
+ *
+ * This also records which regions differ from the storage, and works out the
+ * CRC. Regions before the first one which changed have the same CRC as before.
+ *
+ * @env: Environment to copy, which may not be aligned
+ * Return: CRC32 of the data in @env
+ */
+static u32 env_image_update(const env_t *env)
+{
+	struct env_image *img = &env_image;
+	bool stored = img->stored;
+	bool same = img->valid;
+	u32 crc = 0;
+	int i;
+
+	/* The image lives in BSS and malloc() space */
+	if (!(gd->flags & GD_FLG_RELOC))
+		return crc32(0, env->data, ENV_SIZE);
+	if (!img->env) {
+		img->env = malloc(sizeof(env_t));
+		if (!img->env)
+			return crc32(0, env->data, ENV_SIZE);
+	}
+
+	memset(img->changed, '\0', sizeof(img->changed));
+	for (i = 0; i < ENV_REGIONS; i++) {
+		ulong start = env_region_data(i);
+		ulong len = env_region_data(i + 1) - start;
+		bool differs;
+
+		differs = !img->valid ||
+			memcmp(img->env->data + start, env->data + start, len);
+		if (differs) {
+			memcpy(img->env->data + start, env->data + start, len);
+			img->current = false;
+			img->stored = false;
+		}
+		if (differs || !stored)
+			img->changed[BIT_WORD(i)] |= BIT_MASK(i);
+
+		if (same && differs) {
+			same = false;
+			crc = img->crc[i];
+		}
+		if (!same) {
+			img->crc[i] = crc;
+			crc = crc32(crc, env->data + start, len);
+		}
+	}
+	if (same)
+		crc = img->crc[ENV_REGIONS];
+	img->crc[ENV_REGIONS] = crc;
+	img->valid = true;
+
+	return crc;
+}
+
+/* Record that the image holds an environment loaded from storage */
+static void env_image_loaded(const env_t *env)
+{
+	struct env_image *img = &env_image;
+
+	env_image_update(env);
+	if (img->valid) {
+		memcpy(img->env, env, ENV_HEADER_SIZE);
+		img->current = false;
+		img->stored = true;
+	}
+}
+
+/*
+ * Copy the data from the image, if it holds the export of the environment as
+ * it is now
+ */
+static bool env_image_get(env_t *env)
+{
+	struct env_image *img = &env_image;
+
+	if (!img->valid || !img->current || hdirty_r(&env_htab))
+		return false;
+	memcpy(env->data, img->env->data, ENV_SIZE);
+
+	return true;
+}
+
+/* Record that the image holds an export of the environment */
+static void env_image_exported(const env_t *env)
+{
+	struct env_image *img = &env_image;
+	int i;
+
+	if (!img->valid)
+		return;
+	hclean_r(&env_htab);
+	img->current = true;
+
+	/* The header changes along with the data, or with each save */
+	for (i = 0; i < ARRAY_SIZE(img->changed); i++) {
+		if (img->changed[i])
+			break;
+	}
+	if (i < ARRAY_SIZE(img->changed) || IS_ENABLED(CONFIG_ENV_REDUNDANT))
+		img->changed[0] |= BIT_MASK(0);
+	memcpy(img->env, env, ENV_HEADER_SIZE);
+}
+
+bool env_export_changed(ulong offset, ulong size)
+{
+	struct env_image *img = &env_image;
+	int i;
+
+	if (!img->valid)
+		return true;
+	for (i = offset / ENV_REGION_SIZE;
+	     i < ENV_REGIONS && i * ENV_REGION_SIZE < offset + size; i++) {
+		if (img->changed[BIT_WORD(i)] & BIT_MASK(i))
+			return true;
+	}
+
+	return false;
+}
+
+void env_set_stored(bool stored)
+{
+	env_image.stored = stored && env_image.valid;
+}
+#else
+static u32 env_image_update(const env_t *env)
+{
+	return crc32(0, env->data, ENV_SIZE);
+}
+
+static void env_image_loaded(const env_t *env)
+{
+}
+
+static bool env_image_get(env_t *env)
+{
+	return false;
+}
+
+static void env_image_exported(const env_t *env)
+{
+}
+#endif
+
 /*
  * Check if CRC is valid and (if yes) import the environment.
  * Note that "buf" may or may not be aligned.
@@ -449,7 +636,7 @@ int env_import(const char *buf, int check, int flags)
 
 		memcpy(&crc, &ep->crc, sizeof(crc));
 
-		if (crc32(0, ep->data, ENV_SIZE) != crc) {
+		if (env_image_update(ep) != crc) {
 			env_set_default("bad CRC", 0);
 			return -ENOMSG; /* needed for env_load() */
 		}
@@ -457,6 +644,7 @@ int env_import(const char *buf, int check, int flags)
 
 	if (himport_r(&env_htab, (char *)ep->data, ENV_SIZE, '\0', flags, 0,
 			0, NULL)) {
+		env_image_loaded(ep);
 		gd->flags |= GD_FLG_ENV_READY;
 
 		/* This has to be done after GD_FLG_ENV_READY is set */
@@ -584,18 +772,23 @@ int env_export(env_t *env_out)
 	char *res;
 	ssize_t	len;
 
-	res = (char *)env_out->data;
-	len = hexport_r(&env_htab, '\0', 0, &res, ENV_SIZE, 0, NULL);
-	if (len < 0) {
-		pr_err("Cannot export environment: errno = %d\n", errno);
-		return 1;
+	/* There is no need to export again if nothing changed */
+	if (!env_image_get(env_out)) {
+		res = (char *)env_out->data;
+		len = hexport_r(&env_htab, '\0', 0, &res, ENV_SIZE, 0, NULL);
+		if (len < 0) {
+			pr_err("Cannot export environment: errno = %d\n",
+			       errno);
+			return 1;
+		}
 	}
 
-	env_out->crc = crc32(0, env_out->data, ENV_SIZE);
+	env_out->crc = env_image_update(env_out);
 
 #ifdef CONFIG_ENV_REDUNDANT
 	env_out->flags = ++env_flags; /* increase the serial */
 #endif
+	env_image_exported(env_out);
 
 	return 0;
 }
@@ -277,6 +277,7 @@ int env_save(void)
 		}
 
 		ret = drv->save();
+		env_set_stored(!ret);
 		if (ret)
 			printf("Failed (%d)\n", ret);
 		else
@@ -309,6 +310,7 @@ int env_erase(void)
 
 		printf("Erasing Environment on %s... ", drv->name);
 		ret = drv->erase();
+		env_set_stored(false);
 		if (ret)
 			printf("Failed (%d)\n", ret);
 		else
@@ -385,6 +387,7 @@ int env_select(const char *name)
 				gd->env_load_prio = prio;
 				gd->env_valid = ENV_INVALID;
 				gd->flags &= ~GD_FLG_ENV_DEFAULT;
+				env_set_stored(false);
 			}
 			printf("OK\n");
 			return 0;
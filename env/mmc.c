@@ -312,18 +312,55 @@ static void fini_mmc_for_env(struct mmc *mmc)
 }
 
 #if defined(CONFIG_CMD_SAVEENV) && !defined(CONFIG_XPL_BUILD)
+/*
+ * Check whether a block of the environment needs to be written
+ *
+ * The block may have been written by other means since the environment was
+ * last loaded or saved (e.g. 'mmc write', ums or fastboot), so a block which
+ * did not change in memory is read back and compared before it is skipped.
+ */
+static bool env_blk_changed(struct mmc *mmc, uint blk, uint blk_start,
+			    const void *buffer)
+{
+	ALLOC_CACHE_ALIGN_BUFFER(u8, cur, MMC_MAX_BLOCK_LEN);
+	struct blk_desc *desc = mmc_get_blk_desc(mmc);
+	ulong len = mmc->write_bl_len;
+
+	/* A redundant copy holds an older environment, so is written in full */
+	if (IS_ENABLED(CONFIG_ENV_REDUNDANT))
+		return true;
+
+	if (env_export_changed(blk * len, len))
+		return true;
+	if (len > MMC_MAX_BLOCK_LEN ||
+	    blk_dread(desc, blk_start + blk, 1, cur) != 1)
+		return true;
+
+	return memcmp(cur, buffer + blk * len, len);
+}
+
 static inline int write_env(struct mmc *mmc, unsigned long size,
 			    unsigned long offset, const void *buffer)
 {
-	uint blk_start, blk_cnt, n;
+	uint blk_start, blk_cnt, blk, n;
 	struct blk_desc *desc = mmc_get_blk_desc(mmc);
 
 	blk_start	= ALIGN(offset, mmc->write_bl_len) / mmc->write_bl_len;
 	blk_cnt		= ALIGN(size, mmc->write_bl_len) / mmc->write_bl_len;
 
-	n = blk_dwrite(desc, blk_start, blk_cnt, (u_char *)buffer);
+	/* Write each run of blocks which changed */
+	for (blk = 0; blk < blk_cnt; blk += n ? n : 1) {
+		for (n = 0; blk + n < blk_cnt; n++) {
+			if (!env_blk_changed(mmc, blk + n, blk_start, buffer))
+				break;
+		}
+		if (n && blk_dwrite(desc, blk_start + blk, n,
+				    (u_char *)buffer +
+				    blk * mmc->write_bl_len) != n)
+			return -1;
+	}
 
-	return (n == blk_cnt) ? 0 : -1;
+	return 0;
 }
 
 static int env_mmc_save(void)
@@ -256,6 +256,35 @@ struct global_data {
 	 */
 	void *dm_priv_base;
 # endif
+# if CONFIG_IS_ENABLED(DM_UCLASS_TABLE)
+	/**
+	 * @uclass_table: uclasses indexed by enum uclass_id, NULL for those
+	 * which have not been created
+	 */
+	struct uclass **uclass_table;
+# endif
+# if CONFIG_IS_ENABLED(DM_COMPAT_INDEX)
+	/**
+	 * @dm_compat_index: sorted table of compatible strings, built in
+	 * dm_init(), or NULL if not built (e.g. out of memory)
+	 */
+	struct lists_compat_entry *dm_compat_index;
+	/** @dm_compat_count: number of entries in @dm_compat_index */
+	int dm_compat_count;
+# endif
+# if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+	/**
+	 * @dm_lazy: devicetree nodes which have not been bound yet, or NULL if
+	 * all nodes are bound as they are scanned
+	 */
+	struct dm_lazy *dm_lazy;
+# endif
+# if CONFIG_IS_ENABLED(DM_POOL)
+	/**
+	 * @dm_pool: pools for driver model data, or NULL if not set up
+	 */
+	struct dm_pool *dm_pool;
+# endif
 #endif
 #ifdef CONFIG_TIMER
 	/**
@@ -269,6 +298,17 @@ struct global_data {
 	 */
 	struct device_node *of_root;
 #endif
+#if CONFIG_IS_ENABLED(OFNODE_PHANDLE_CACHE)
+	/**
+	 * @phandle_cache: cache of phandle lookups in the control tree
+	 */
+	struct ofnode_phandle_cache *phandle_cache;
+	/**
+	 * @phandle_cache_reloc: true if @phandle_cache was allocated after
+	 * relocation
+	 */
+	bool phandle_cache_reloc;
+#endif
 #if CONFIG_IS_ENABLED(MULTI_DTB_FIT)
 	/**
 	 * @multi_dtb_fit: pointer to uncompressed multi-dtb FIT image
@@ -475,6 +515,20 @@ static_assert(sizeof(struct global_data) == GD_SIZE);
 #define gd_set_of_root(_root)
 #endif
 
+#if CONFIG_IS_ENABLED(OFNODE_PHANDLE_CACHE)
+#define gd_phandle_cache()		gd->phandle_cache
+#define gd_phandle_cache_reloc()	gd->phandle_cache_reloc
+#define gd_set_phandle_cache(_cache, _reloc) \
+	do { \
+		gd->phandle_cache = (_cache); \
+		gd->phandle_cache_reloc = (_reloc); \
+	} while (0)
+#else
+#define gd_phandle_cache()		NULL
+#define gd_phandle_cache_reloc()	false
+#define gd_set_phandle_cache(_cache, _reloc)
+#endif
+
 #if CONFIG_IS_ENABLED(OF_PLATDATA_DRIVER_RT)
 #define gd_set_dm_driver_rt(dyn)	gd->dm_driver_rt = dyn
 #define gd_dm_driver_rt()		gd->dm_driver_rt
@@ -495,6 +549,44 @@ static_assert(sizeof(struct global_data) == GD_SIZE);
 #define gd_dm_priv_base()		NULL
 #endif
 
+#if CONFIG_IS_ENABLED(DM_UCLASS_TABLE)
+#define gd_uclass_table()		gd->uclass_table
+#define gd_set_uclass_table(_table)	gd->uclass_table = (_table)
+#else
+#define gd_uclass_table()		NULL
+#define gd_set_uclass_table(_table)
+#endif
+
+#if CONFIG_IS_ENABLED(DM_COMPAT_INDEX)
+#define gd_dm_compat_index()		gd->dm_compat_index
+#define gd_dm_compat_count()		gd->dm_compat_count
+#define gd_set_dm_compat_index(_idx, _count) \
+	do { \
+		gd->dm_compat_index = (_idx); \
+		gd->dm_compat_count = (_count); \
+	} while (0)
+#else
+#define gd_dm_compat_index()		NULL
+#define gd_dm_compat_count()		0
+#define gd_set_dm_compat_index(_idx, _count)
+#endif
+
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+#define gd_dm_lazy()			gd->dm_lazy
+#define gd_set_dm_lazy(_lazy)		gd->dm_lazy = (_lazy)
+#else
+#define gd_dm_lazy()			NULL
+#define gd_set_dm_lazy(_lazy)
+#endif
+
+#if CONFIG_IS_ENABLED(DM_POOL)
+#define gd_dm_pool()			gd->dm_pool
+#define gd_set_dm_pool(_pool)		gd->dm_pool = (_pool)
+#else
+#define gd_dm_pool()			NULL
+#define gd_set_dm_pool(_pool)
+#endif
+
 #ifdef CONFIG_ACPI
 #define gd_acpi_ctx()		gd->acpi_ctx
 #define gd_acpi_start()		gd->acpi_start
@@ -335,6 +335,21 @@ uint32_t bootstage_start(enum bootstage_id id, const char *name);
  */
 uint32_t bootstage_accum(enum bootstage_id id);
 
+/**
+ * bootstage_add_accum() - Add an accumulated time measured elsewhere
+ *
+ * This adds a record showing the total time spent in an activity, when that
+ * time has been measured by other code rather than with bootstage_start() and
+ * bootstage_accum(). If a record with the same name was added by this
+ * function before, its time is updated.
+ *
+ * @name: Name of the activity. This must remain valid, since only the pointer
+ *	is stored
+ * @time_us: Total time spent in the activity, in microseconds
+ * Return: 0 if OK, -ENOSPC if there is no space for a new record
+ */
+int bootstage_add_accum(const char *name, uint32_t time_us);
+
 /* Print a report about boot time */
 void bootstage_report(void);
 
@@ -435,6 +450,11 @@ static inline uint32_t bootstage_accum(enum bootstage_id id)
 	return 0;
 }
 
+static inline int bootstage_add_accum(const char *name, uint32_t time_us)
+{
+	return 0;
+}
+
 static inline int bootstage_stash(void *base, int size)
 {
 	return 0;	/* Pretend to succeed */
@@ -87,6 +87,14 @@ struct driver_info;
  */
 #define DM_FLAG_PROBE_AFTER_BIND	(1 << 15)
 
+/*
+ * With CONFIG_DM_PROBE_THREADS, dm_autoprobe() may probe this driver's devices
+ * in a thread, alongside devices on other buses. The driver must cope with
+ * other threads running while it waits in udelay() or schedule(). Devices on
+ * the same bus are still probed one after the other.
+ */
+#define DM_FLAG_PROBE_THREAD		(1 << 16)
+
 /*
  * One or multiple of these flags are passed to device_remove() so that
  * a selective device removal as specified by the remove-stage and the
@@ -115,6 +123,29 @@ enum {
 	DM_REMOVE_NO_PD		= 1 << 1,
 };
 
+/**
+ * struct udevice_timing - Time spent in each driver-model stage of a device
+ *
+ * This is only present with CONFIG_DM_TIMING. Times are in microseconds, are
+ * accumulated if the device is probed more than once, and include any nested
+ * work, such as probing another device from within a driver method.
+ *
+ * @bind_us: Time taken to bind the device, including its bind() methods
+ * @of_to_plat_us: Time taken by the driver's of_to_plat() method
+ * @pre_probe_us: Time taken to prepare the device for probing, including power
+ *	domains, pinctrl, the uclass pre_probe() and parent child_pre_probe()
+ *	methods and default clocks
+ * @probe_us: Time taken by the driver's probe() method
+ * @post_probe_us: Time taken by the uclass post_probe() method
+ */
+struct udevice_timing {
+	u32 bind_us;
+	u32 of_to_plat_us;
+	u32 pre_probe_us;
+	u32 probe_us;
+	u32 post_probe_us;
+};
+
 /**
  * struct udevice - An instance of a driver
  *
@@ -169,6 +200,10 @@ enum {
  * @dma_offset: Offset between the physical address space (CPU's) and the
  *		device's bus address space
  * @iommu: IOMMU device associated with this device
+ * @probe_thread: Thread which is probing this device, or NULL if none (do not
+ *	access outside driver model)
+ * @timing: Time spent binding and probing this device (do not access outside
+ *	driver model)
  */
 struct udevice {
 	const struct driver *driver;
@@ -201,6 +236,12 @@ struct udevice {
 #if CONFIG_IS_ENABLED(IOMMU)
 	struct udevice *iommu;
 #endif
+#if CONFIG_IS_ENABLED(DM_PROBE_THREADS)
+	struct uthread *probe_thread;
+#endif
+#if CONFIG_IS_ENABLED(DM_TIMING)
+	struct udevice_timing timing;
+#endif
 };
 
 static inline int dm_udevice_size(void)
@@ -269,8 +310,20 @@ static inline __attribute_const__ ofnode dev_ofnode(const struct udevice *dev)
 #endif
 }
 
+#if CONFIG_IS_ENABLED(DM_PROBE_THREADS)
+/**
+ * device_active() - Check whether a device is active (probed and not removed)
+ *
+ * A device which another thread is still probing is not active yet.
+ *
+ * @dev: Device to check
+ * Return: true if the device is active
+ */
+bool device_active(const struct udevice *dev);
+#else
 /* Returns non-zero if the device is active (probed and not removed) */
 #define device_active(dev)	(dev_get_flags(dev) & DM_FLAG_ACTIVATED)
+#endif
 
 #if CONFIG_IS_ENABLED(DM_DMA)
 #define dev_set_dma_offset(_dev, _offset)	_dev->dma_offset = _offset
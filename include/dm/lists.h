@@ -12,6 +12,25 @@
 #include <dm/ofnode.h>
 #include <dm/uclass-id.h>
 
+struct driver;
+struct udevice_id;
+
+/**
+ * struct lists_compat_entry - Entry in the index of compatible strings
+ *
+ * The index holds one entry for each compatible string in each driver's
+ * of_match table, sorted by compatible string and then by the position of the
+ * driver in the linker list, so that a search finds the same driver as a walk
+ * through the list would.
+ *
+ * @id: Match entry, giving the compatible string and driver data
+ * @drv: Driver which owns @id
+ */
+struct lists_compat_entry {
+	const struct udevice_id *id;
+	struct driver *drv;
+};
+
 /**
  * lists_driver_lookup_name() - Return u_boot_driver corresponding to name
  *
@@ -45,6 +64,28 @@ struct uclass_driver *lists_uclass_lookup(enum uclass_id id);
  */
 int lists_bind_drivers(struct udevice *parent, bool pre_reloc_only);
 
+/**
+ * lists_compat_index_init() - Build the index of compatible strings
+ *
+ * This collects the compatible strings of all drivers into a sorted table held
+ * in global_data, which lists_bind_fdt() then searches instead of walking the
+ * driver list. It is called from dm_init() when CONFIG_DM_COMPAT_INDEX is
+ * enabled. If it fails, binding still works but is slower.
+ *
+ * Return: 0 if OK, -ENOMEM if out of memory
+ */
+int lists_compat_index_init(void);
+
+/**
+ * lists_driver_lookup_compat() - Find the first driver for a compatible string
+ *
+ * This finds the driver which lists_bind_fdt() would try first for @compat.
+ *
+ * @compat: Compatible string to look up
+ * Return: pointer to driver, or NULL if none matches
+ */
+struct driver *lists_driver_lookup_compat(const char *compat);
+
 /**
  * lists_bind_fdt() - bind a device tree node
  *
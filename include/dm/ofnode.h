@@ -385,6 +385,44 @@ static inline oftree oftree_from_np(struct device_node *root)
  */
 void oftree_dispose(oftree tree);
 
+/**
+ * ofnode_phandle_cache_init() - Set up the cache of phandle lookups
+ *
+ * This allocates the cache if needed and empties it. It is called by
+ * dm_init(). In U-Boot proper nothing is allocated before relocation. Until
+ * the cache is set up, and if this fails, phandle lookups search the tree.
+ *
+ * Return: 0 if OK, -ENOMEM if out of memory
+ */
+int ofnode_phandle_cache_init(void);
+
+/**
+ * ofnode_phandle_cache_find() - Look up a phandle in the cache
+ *
+ * This only covers the control tree. The node is checked against the tree
+ * before it is returned.
+ *
+ * @phandle: Phandle to look up
+ * Return: node with that phandle, or ofnode_null() if not in the cache
+ */
+ofnode ofnode_phandle_cache_find(uint phandle);
+
+/**
+ * ofnode_phandle_cache_add() - Add a phandle lookup to the cache
+ *
+ * @phandle: Phandle which was looked up in the control tree
+ * @node: Node which has that phandle (nothing is added if not valid)
+ */
+void ofnode_phandle_cache_add(uint phandle, ofnode node);
+
+/**
+ * ofnode_phandle_cache_clear() - Empty the cache of phandle lookups
+ *
+ * This must be called when a node is removed from the live tree, since the
+ * removed node still holds its phandle.
+ */
+void ofnode_phandle_cache_clear(void);
+
 /**
  * ofnode_name_eq() - Check a node name ignoring its unit address
  *
@@ -448,6 +486,67 @@ int ofnode_read_u16(ofnode node, const char *propname, u16 *outp);
  */
 u16 ofnode_read_u16_default(ofnode node, const char *propname, u16 def);
 
+#if CONFIG_IS_ENABLED(OFNODE_INLINE_READ)
+#include <asm/global_data.h>
+
+/*
+ * Without a live tree, a node is always an offset in the control FDT, so the
+ * common property readers can go straight to libfdt
+ */
+static inline const void *ofnode_get_property(ofnode node,
+					      const char *propname, int *lenp)
+{
+	return fdt_getprop(ofnode_to_fdt(node), ofnode_to_offset(node),
+			   propname, lenp);
+}
+
+static inline bool ofnode_has_property(ofnode node, const char *propname)
+{
+	return ofnode_get_property(node, propname, NULL);
+}
+
+static inline bool ofnode_read_bool(ofnode node, const char *propname)
+{
+	assert(ofnode_valid(node));
+
+	return ofnode_has_property(node, propname);
+}
+
+static inline int ofnode_read_u32(ofnode node, const char *propname,
+				  u32 *outp)
+{
+	const fdt32_t *cell;
+	int len;
+
+	assert(ofnode_valid(node));
+	cell = ofnode_get_property(node, propname, &len);
+	if (!cell)
+		return -EINVAL;
+	if (len < sizeof(*cell))
+		return -EOVERFLOW;
+	*outp = fdt32_to_cpu(*cell);
+
+	return 0;
+}
+
+static inline u32 ofnode_read_u32_default(ofnode node, const char *propname,
+					  u32 def)
+{
+	assert(ofnode_valid(node));
+
+	return fdtdec_get_uint(ofnode_to_fdt(node), ofnode_to_offset(node),
+			       propname, def);
+}
+
+static inline int ofnode_read_s32_default(ofnode node, const char *propname,
+					  s32 def)
+{
+	assert(ofnode_valid(node));
+
+	return fdtdec_get_int(ofnode_to_fdt(node), ofnode_to_offset(node),
+			      propname, def);
+}
+#else
 /**
  * ofnode_read_u32() - Read a 32-bit integer from a property
  *
@@ -458,6 +557,55 @@ u16 ofnode_read_u16_default(ofnode node, const char *propname, u16 def);
  */
 int ofnode_read_u32(ofnode node, const char *propname, u32 *outp);
 
+/**
+ * ofnode_read_u32_default() - Read a 32-bit integer from a property
+ *
+ * @node:	valid node reference to read property from
+ * @propname:	name of the property to read from
+ * @def:	default value to return if the property has no value
+ * Return: property value, or @def if not found
+ */
+u32 ofnode_read_u32_default(ofnode node, const char *propname, u32 def);
+
+/**
+ * ofnode_read_s32_default() - Read a 32-bit integer from a property
+ *
+ * @node:	valid node reference to read property from
+ * @propname:	name of the property to read from
+ * @def:	default value to return if the property has no value
+ * Return: property value, or @def if not found
+ */
+int ofnode_read_s32_default(ofnode node, const char *propname, s32 def);
+
+/**
+ * ofnode_get_property() - get a pointer to the value of a node property
+ *
+ * @node: node to read
+ * @propname: property to read
+ * @lenp: place to put length on success
+ * Return: pointer to property value, or NULL if not found or empty
+ */
+const void *ofnode_get_property(ofnode node, const char *propname, int *lenp);
+
+/**
+ * ofnode_has_property() - check if a node has a named property
+ *
+ * @node: node to read
+ * @propname: property to read
+ * Return: true if the property exists in the node, false if not
+ */
+bool ofnode_has_property(ofnode node, const char *propname);
+
+/**
+ * ofnode_read_bool() - read a boolean value from a property
+ *
+ * @node:	valid node reference to read property from
+ * @propname:	name of property to read
+ * Return: true if property is present (meaning true), false if not present
+ */
+bool ofnode_read_bool(ofnode node, const char *propname);
+#endif /* OFNODE_INLINE_READ */
+
 /**
  * ofnode_read_u32_index() - Read a 32-bit integer from a multi-value property
  *
@@ -496,16 +644,6 @@ static inline int ofnode_read_s32(ofnode node, const char *propname,
 	return ofnode_read_u32(node, propname, (u32 *)outp);
 }
 
-/**
- * ofnode_read_u32_default() - Read a 32-bit integer from a property
- *
- * @node:	valid node reference to read property from
- * @propname:	name of the property to read from
- * @def:	default value to return if the property has no value
- * Return: property value, or @def if not found
- */
-u32 ofnode_read_u32_default(ofnode node, const char *propname, u32 def);
-
 /**
  * ofnode_read_u32_index_default() - Read a 32-bit integer from a multi-value
  *                                   property
@@ -519,16 +657,6 @@ u32 ofnode_read_u32_default(ofnode node, const char *propname, u32 def);
 u32 ofnode_read_u32_index_default(ofnode node, const char *propname, int index,
 				  u32 def);
 
-/**
- * ofnode_read_s32_default() - Read a 32-bit integer from a property
- *
- * @node:	valid node reference to read property from
- * @propname:	name of the property to read from
- * @def:	default value to return if the property has no value
- * Return: property value, or @def if not found
- */
-int ofnode_read_s32_default(ofnode node, const char *propname, s32 def);
-
 /**
  * ofnode_read_u64() - Read a 64-bit integer from a property
  *
@@ -588,15 +716,6 @@ const char *ofnode_read_string(ofnode node, const char *propname);
 int ofnode_read_u32_array(ofnode node, const char *propname,
 			  u32 *out_values, size_t sz);
 
-/**
- * ofnode_read_bool() - read a boolean value from a property
- *
- * @node:	valid node reference to read property from
- * @propname:	name of property to read
- * Return: true if property is present (meaning true), false if not present
- */
-bool ofnode_read_bool(ofnode node, const char *propname);
-
 /**
  * ofnode_find_subnode() - find a named subnode of a parent node
  *
@@ -1158,25 +1277,6 @@ int ofnode_decode_display_timing(ofnode node, int index,
 int ofnode_decode_panel_timing(ofnode node,
 			       struct display_timing *config);
 
-/**
- * ofnode_get_property() - get a pointer to the value of a node property
- *
- * @node: node to read
- * @propname: property to read
- * @lenp: place to put length on success
- * Return: pointer to property value, or NULL if not found or empty
- */
-const void *ofnode_get_property(ofnode node, const char *propname, int *lenp);
-
-/**
- * ofnode_has_property() - check if a node has a named property
- *
- * @node: node to read
- * @propname: property to read
- * Return: true if the property exists in the node, false if not
- */
-bool ofnode_has_property(ofnode node, const char *propname);
-
 /**
  * ofnode_first_property()- get the reference of the first property
  *
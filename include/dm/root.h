@@ -9,13 +9,33 @@
 #ifndef _DM_ROOT_H_
 #define _DM_ROOT_H_
 
+#include <dm/ofnode_decl.h>
 #include <dm/tag.h>
+#include <dm/uclass-id.h>
 
 struct udevice;
 
 /* Head of the uclass list if CONFIG_OF_PLATDATA_INST is enabled */
 extern struct list_head uclass_head;
 
+/* Number of pools used when CONFIG_DM_POOL is enabled */
+#define DM_POOL_COUNT		5
+
+/**
+ * struct dm_pool_stats - Information about a driver model memory pool
+ *
+ * @size: Size of each object in the pool, in bytes
+ * @slab_count: Number of slabs allocated for the pool
+ * @total: Number of objects in all slabs
+ * @used: Number of objects in use
+ */
+struct dm_pool_stats {
+	int size;
+	int slab_count;
+	int total;
+	int used;
+};
+
 /**
  * struct dm_stats - Information about driver model memory usage
  *
@@ -34,6 +54,7 @@ extern struct list_head uclass_head;
  * @attach_size_total: Total number of bytes of attached data
  * @attach_count: Number of devices with attached, for each type
  * @attach_size: Total number of bytes of attached data, for each type
+ * @pool: Usage of each pool, if CONFIG_DM_POOL is enabled
  */
 struct dm_stats {
 	int total_size;
@@ -50,6 +71,7 @@ struct dm_stats {
 	int attach_size_total;
 	int attach_count[DM_TAG_ATTACH_COUNT];
 	int attach_size[DM_TAG_ATTACH_COUNT];
+	struct dm_pool_stats pool[DM_POOL_COUNT];
 };
 
 /**
@@ -211,4 +233,210 @@ void dm_get_stats(int *device_countp, int *uclass_countp);
  */
 void dm_get_mem(struct dm_stats *stats);
 
+/**
+ * struct dm_driver_timing - Time and memory used by the devices of a driver
+ *
+ * @drv: Driver
+ * @dev_count: Number of devices using this driver
+ * @time_us: Total time spent binding and probing those devices, in
+ *	microseconds
+ * @mem: Total bytes of heap used on behalf of those devices
+ */
+struct dm_driver_timing {
+	const struct driver *drv;
+	int dev_count;
+	ulong time_us;
+	ulong mem;
+};
+
+/**
+ * dev_get_time_us() - Get the time spent binding and probing a device
+ *
+ * This requires CONFIG_DM_TIMING
+ *
+ * @dev: Device to check
+ * Return: total time recorded for @dev, in microseconds
+ */
+ulong dev_get_time_us(const struct udevice *dev);
+
+/**
+ * dev_get_mem() - Get the heap used on behalf of a device
+ *
+ * This includes the struct udevice itself, the data which driver model
+ * attaches to it (plat, priv, etc.) and any devres allocations. It does not
+ * include memory which the driver allocates with plain malloc().
+ *
+ * @dev: Device to check
+ * Return: number of bytes used
+ */
+ulong dev_get_mem(const struct udevice *dev);
+
+/**
+ * dm_get_driver_timing() - Get the time used by each driver, slowest first
+ *
+ * This requires CONFIG_DM_TIMING
+ *
+ * @listp: Returns an allocated list of drivers with at least one device,
+ *	sorted by decreasing time. The caller must free this.
+ * Return: number of entries in the list, or -ENOMEM if out of memory
+ */
+int dm_get_driver_timing(struct dm_driver_timing **listp);
+
+#if CONFIG_IS_ENABLED(DM_TIMING)
+/**
+ * dm_timing_add_bootstage() - Add the slowest drivers to bootstage
+ *
+ * This adds an accumulated-time record for each of the slowest drivers, so
+ * that they appear in the bootstage report and in the bootstage data passed
+ * to the OS. Calling it again updates the existing records.
+ */
+void dm_timing_add_bootstage(void);
+#else
+static inline void dm_timing_add_bootstage(void) { }
+#endif
+
+#if CONFIG_IS_ENABLED(DM_POOL)
+/**
+ * dm_pool_init() - Set up the pools for driver model data
+ *
+ * Return: 0 if OK, -ENOMEM if out of memory
+ */
+int dm_pool_init(void);
+
+/**
+ * dm_pool_uninit() - Free all pools
+ *
+ * Any objects still allocated from the pools become invalid
+ */
+void dm_pool_uninit(void);
+
+/**
+ * dm_pool_alloc() - Allocate zeroed memory for driver model data
+ *
+ * This uses the smallest pool with objects of at least @size bytes, falling
+ * back to calloc() if there is none, or if the pools are not set up
+ *
+ * @size: Number of bytes to allocate
+ * Return: pointer to memory, or NULL if out of memory
+ */
+void *dm_pool_alloc(int size);
+
+/**
+ * dm_pool_free() - Free memory allocated by dm_pool_alloc()
+ *
+ * This also accepts memory allocated by malloc(), which is passed to free()
+ *
+ * @ptr: Memory to free, or NULL
+ */
+void dm_pool_free(void *ptr);
+
+/**
+ * dm_pool_get_stats() - Get information about the pools
+ *
+ * @stats: Returns information for each of the DM_POOL_COUNT pools
+ */
+void dm_pool_get_stats(struct dm_pool_stats *stats);
+#else
+static inline int dm_pool_init(void) { return 0; }
+static inline void dm_pool_uninit(void) { }
+#define dm_pool_alloc(_size)	calloc(1, _size)
+#define dm_pool_free(_ptr)	free(_ptr)
+static inline void dm_pool_get_stats(struct dm_pool_stats *stats) { }
+#endif
+
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+/**
+ * dm_lazy_init() - Start recording devicetree nodes instead of binding them
+ *
+ * After this, dm_scan_fdt() and dm_scan_fdt_dev() record nodes which are not
+ * needed immediately, rather than binding them. See CONFIG_DM_LAZY_BIND
+ *
+ * Return: 0 if OK, -ENOMEM if out of memory
+ */
+int dm_lazy_init(void);
+
+/**
+ * dm_lazy_uninit() - Forget all recorded nodes and stop recording them
+ */
+void dm_lazy_uninit(void);
+
+/**
+ * dm_lazy_defer() - Record a devicetree node instead of binding it
+ *
+ * A node is not recorded if it has a bootph-* property, or if it or any of
+ * its subnodes may provide a uclass in CONFIG_DM_LAZY_BIND_UCLASSES, or if no
+ * driver matches it or its subnodes.
+ *
+ * @parent: Parent device for the node
+ * @node: Node to check
+ * @pre_reloc_only: true if only pre-relocation nodes are being bound
+ * Return: true if the node was recorded, false if it must be bound now
+ */
+bool dm_lazy_defer(struct udevice *parent, ofnode node, bool pre_reloc_only);
+
+/**
+ * dm_lazy_bind_uclass() - Bind recorded nodes which may provide a uclass
+ *
+ * @id: Uclass ID to bind devices for
+ * Return: 0 if OK, -ve on error
+ */
+int dm_lazy_bind_uclass(enum uclass_id id);
+
+/**
+ * dm_lazy_bind_ofnode() - Bind the device for a recorded node
+ *
+ * This binds @node if it was recorded, along with any recorded parent nodes
+ * needed to reach it. This also covers nodes whose device is bound by the
+ * bind() method of a parent, such as PMIC regulators, which are not recorded
+ * themselves.
+ *
+ * @node: Node to bind
+ * Return: number of recorded nodes bound (0 if none), or -ve on error
+ */
+int dm_lazy_bind_ofnode(ofnode node);
+
+/**
+ * dm_lazy_bind_children() - Bind the recorded child nodes of a device
+ *
+ * This is used when looking through the children of a device, so that those
+ * which were recorded are not missed, e.g. the chips on an I2C bus.
+ *
+ * @parent: Device whose recorded child nodes should be bound
+ * Return: number of nodes bound, or -ve on error
+ */
+int dm_lazy_bind_children(const struct udevice *parent);
+
+/**
+ * dm_lazy_bind_all() - Bind all recorded nodes
+ *
+ * Return: number of nodes bound, or -ve on error
+ */
+int dm_lazy_bind_all(void);
+
+/**
+ * dm_lazy_drop() - Forget the recorded nodes of a device being unbound
+ *
+ * @parent: Device whose child nodes should be forgotten
+ */
+void dm_lazy_drop(struct udevice *parent);
+#else
+static inline int dm_lazy_init(void) { return 0; }
+static inline void dm_lazy_uninit(void) { }
+static inline bool dm_lazy_defer(struct udevice *parent, ofnode node,
+				 bool pre_reloc_only)
+{
+	return false;
+}
+
+static inline int dm_lazy_bind_uclass(enum uclass_id id) { return 0; }
+static inline int dm_lazy_bind_ofnode(ofnode node) { return 0; }
+static inline int dm_lazy_bind_children(const struct udevice *parent)
+{
+	return 0;
+}
+
+static inline int dm_lazy_bind_all(void) { return 0; }
+static inline void dm_lazy_drop(struct udevice *parent) { }
+#endif
+
 #endif
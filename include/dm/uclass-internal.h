@@ -335,6 +335,20 @@ int uclass_get_count(void);
  */
 struct uclass *uclass_find(enum uclass_id key);
 
+/**
+ * uclass_get_nolazy() - Get a uclass without binding any recorded nodes
+ *
+ * This is the same as uclass_get() except that it does not bind devicetree
+ * nodes recorded by CONFIG_DM_LAZY_BIND. It is used when binding a device, so
+ * that this does not bind all the other recorded devices in its uclass.
+ *
+ * @key: ID to look up
+ * @ucp: Returns pointer to uclass (there is only one per ID)
+ * Return: 0 if OK, -EDEADLK if driver model is not yet inited, other -ve on
+ * other error
+ */
+int uclass_get_nolazy(enum uclass_id key, struct uclass **ucp);
+
 /**
  * uclass_destroy() - Destroy a uclass
  *
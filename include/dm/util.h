@@ -22,8 +22,10 @@ struct list_head;
  * @dev_name: udevice name
  * @extended: true if forword-matching expected
  * @sort: Sort by uclass name
+ * @timing: Show the time and memory used by each device, followed by the
+ *	slowest drivers (requires CONFIG_DM_TIMING)
  */
-void dm_dump_tree(char *dev_name, bool extended, bool sort);
+void dm_dump_tree(char *dev_name, bool extended, bool sort, bool timing);
 
 /*
  * Dump out a list of uclasses and their devices
@@ -273,6 +273,46 @@ const char *env_fat_get_intf(void);
  * Return: string of device and partition
  */
 char *env_fat_get_dev_part(void);
+
+#if CONFIG_IS_ENABLED(ENV_SAVE_INCREMENTAL)
+/**
+ * env_export_changed() - Check whether part of the exported environment changed
+ *
+ * Just after env_export(), this tells a driver whether a range of the
+ * resulting env_t differs from what was last loaded from, or saved to, the
+ * storage. The driver can then skip writing the parts which are the same. This
+ * must not be used when saving to a redundant copy, which holds an older
+ * environment. The storage may have been written by other means since then,
+ * so the driver should check that it still holds the range before skipping
+ * it.
+ *
+ * @offset: Offset of the range within the env_t
+ * @size: Size of the range in bytes
+ * Return: true if the range may have changed, false if it is the same
+ */
+bool env_export_changed(ulong offset, ulong size);
+
+/**
+ * env_set_stored() - Record whether the storage holds the exported environment
+ *
+ * This is called after the environment is saved or erased, or a different
+ * location is selected, so that env_export_changed() knows what the storage
+ * holds.
+ *
+ * @stored: true if the environment last exported was saved, false if the
+ *	contents of the storage are not known
+ */
+void env_set_stored(bool stored);
+#else
+static inline bool env_export_changed(ulong offset, ulong size)
+{
+	return true;
+}
+
+static inline void env_set_stored(bool stored)
+{
+}
+#endif
 #endif /* DO_DEPS_ONLY */
 
 #endif /* _ENV_INTERNAL_H_ */
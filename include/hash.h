@@ -8,6 +8,8 @@
 
 #ifdef USE_HOSTCC
 #include <linux/kconfig.h>
+#else
+#include <linux/types.h>
 #endif
 
 struct cmd_tbl;
@@ -82,6 +84,31 @@ struct hash_algo {
 			   int size);
 };
 
+/**
+ * struct hash_stream - A hash calculated while data is being loaded
+ *
+ * Loaders update this as each piece of data lands in memory, so that the
+ * data does not need to be read again to check it. The data must arrive in
+ * order, although pieces which were seen already are ignored.
+ *
+ * @algo: Algorithm in use, or NULL if not started
+ * @ctx: Context for progressive hashing, or NULL when finished
+ * @size: Number of bytes hashed so far
+ * @digest: Resulting digest, valid when @done is true
+ * @digest_size: Size of @digest in bytes
+ * @done: true if @digest holds the digest of the first @size bytes
+ * @failed: true if some data was missed or hashing failed
+ */
+struct hash_stream {
+	struct hash_algo *algo;
+	void *ctx;
+	ulong size;
+	uint8_t digest[HASH_MAX_DIGEST_SIZE];
+	int digest_size;
+	bool done;
+	bool failed;
+};
+
 #ifndef USE_HOSTCC
 /**
  * hash_command: Process a hash command for a particular algorithm
@@ -120,6 +147,54 @@ int hash_command(const char *algo_name, int flags, struct cmd_tbl *cmdtp,
 int hash_block(const char *algo_name, const void *data, unsigned int len,
 	       uint8_t *output, int *output_size);
 
+/**
+ * hash_stream_start() - Start hashing data as it is loaded
+ *
+ * @hs: Stream to set up
+ * @algo_name: Hash algorithm to use, which must support progressive hashing
+ * Return: 0 if ok, -EPROTONOSUPPORT for an unknown algorithm, -ENOMEM if
+ * there is no memory for the context
+ */
+int hash_stream_start(struct hash_stream *hs, const char *algo_name);
+
+/**
+ * hash_stream_update() - Add newly loaded data to a stream
+ *
+ * Data before @hs->size is skipped, so a piece which is received again, or
+ * which overlaps the previous one, is fine. If there is a gap then the stream
+ * is marked as failed and stops hashing.
+ *
+ * This does nothing if @hs is NULL, not started, finished or failed.
+ *
+ * @hs: Stream to update, or NULL
+ * @offset: Offset of @buf within the data being loaded
+ * @buf: Data which was loaded
+ * @size: Size of @buf in bytes
+ * Return: 0 if ok, -EIO if there was a gap or the hash failed
+ */
+int hash_stream_update(struct hash_stream *hs, ulong offset, const void *buf,
+		       ulong size);
+
+/**
+ * hash_stream_finish() - Finish a stream and produce its digest
+ *
+ * On success @hs->done is set and @hs->digest holds the digest of the first
+ * @hs->size bytes. On failure the context is freed anyway.
+ *
+ * @hs: Stream to finish
+ * Return: 0 if ok, -EIO if the stream failed, -ENOENT if not started
+ */
+int hash_stream_finish(struct hash_stream *hs);
+
+/**
+ * hash_stream_abort() - Stop a stream without producing a digest
+ *
+ * This frees the context, if any, and marks the stream as failed.
+ *
+ * @hs: Stream to abort, or NULL
+ */
+void hash_stream_abort(struct hash_stream *hs);
+
 #endif /* !USE_HOSTCC */
 
 /**
@@ -1345,6 +1345,25 @@ int fit_image_verify_with_data(const void *fit, int image_noffset,
 			       const void *key_blob, const void *data,
 			       size_t size);
 
+/**
+ * fit_image_verify_with_stream() - Verify an image using a digest from loading
+ *
+ * This is like fit_image_verify_with_data() but a hash node which uses the
+ * same algorithm as @hs is checked against the digest in @hs, rather than
+ * hashing @data again. Other hash nodes and any signatures still use @data.
+ *
+ * @fit:	Pointer to the FIT format image header
+ * @image_offset: Offset in @fit of image to verify
+ * @key_blob:	FDT containing public keys
+ * @data:	Image data to verify
+ * @size:	Size of image data
+ * @hs:		Hash of the data calculated while loading it, or NULL
+ * Return: 1 if the image is valid, 0 otherwise
+ */
+int fit_image_verify_with_stream(const void *fit, int image_noffset,
+				 const void *key_blob, const void *data,
+				 size_t size, const struct hash_stream *hs);
+
 int fit_image_verify(const void *fit, int noffset);
 #if CONFIG_IS_ENABLED(FIT_SIGNATURE)
 int fit_config_verify(const void *fit, int conf_noffset);
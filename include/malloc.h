@@ -991,6 +991,45 @@ extern ulong mem_malloc_brk;
  */
 void mem_malloc_init(ulong start, ulong size);
 
+/**
+ * struct malloc_info - Information about the malloc() pool
+ *
+ * Sizes include the malloc() overhead for each chunk. Chunks held by the
+ * small-chunk cache (CONFIG_SYS_MALLOC_SMALL) are counted separately.
+ *
+ * @total_bytes: Bytes of the pool which have been used so far
+ * @in_use_bytes: Bytes in allocated chunks, not including the cache
+ * @free_bytes: Bytes in free chunks, including the top chunk
+ * @free_chunks: Number of free chunks, including the top chunk
+ * @largest_free: Size of the largest free chunk in bytes
+ * @small_chunks: Number of chunks in the small-chunk cache
+ * @small_bytes: Bytes in the small-chunk cache
+ * @malloc_count: Number of allocations since the pool was set up
+ * @free_count: Number of frees since the pool was set up
+ * @small_hits: Number of allocations served from the small-chunk cache
+ */
+struct malloc_info {
+	ulong total_bytes;
+	ulong in_use_bytes;
+	ulong free_bytes;
+	ulong free_chunks;
+	ulong largest_free;
+	ulong small_chunks;
+	ulong small_bytes;
+	ulong malloc_count;
+	ulong free_count;
+	ulong small_hits;
+};
+
+/**
+ * malloc_get_info() - Get information about the malloc() pool
+ *
+ * This walks the free lists, so takes longer with a fragmented pool.
+ *
+ * @info: Returns the information
+ */
+void malloc_get_info(struct malloc_info *info);
+
 #ifdef __cplusplus
 };  /* end of extern "C" */
 #endif
@@ -749,6 +749,7 @@ struct mmc {
 	char op_cond_pending;	/* 1 if we are waiting on an op_cond command */
 	char init_in_progress;	/* 1 if we have done mmc_start_init() */
 	char preinit;		/* start init as early as possible */
+	char init_async;	/* op_cond is being polled from cyclic */
 	int ddr_mode;
 #if CONFIG_IS_ENABLED(DM_MMC)
 	struct udevice *dev;	/* Device for this MMC controller */
@@ -780,6 +781,7 @@ struct mmc {
 	 * zero-size structure and does not add any space here.
 	 */
 	struct cyclic_info cyclic;
+	struct cyclic_info init_cyclic;	/* op_cond polling, MMC_ASYNC_INIT */
 };
 
 #if CONFIG_IS_ENABLED(DM_MMC)
@@ -973,6 +975,19 @@ int mmc_get_op_cond(struct mmc *mmc, bool quiet);
  */
 int mmc_start_init(struct mmc *mmc);
 
+/**
+ * mmc_start_init_async() - Start device initialization in the background
+ *
+ * Like mmc_start_init(), but an eMMC card which is still busy after its
+ * first SEND_OP_COND is left powering up, and the OCR is polled from a
+ * cyclic function instead of blocking the caller. The initialization is
+ * completed by mmc_init(), normally when the block device is first probed.
+ *
+ * @mmc:	Pointer to a MMC device struct
+ * Return: 0 on success, <0 on error.
+ */
+int mmc_start_init_async(struct mmc *mmc);
+
 /**
  * Set preinit flag of mmc device.
  *
@@ -147,6 +147,41 @@ extern u32	net_boot_file_size;
 /* Boot file size in blocks as reported by the DHCP server */
 extern u32	net_boot_file_expected_size_in_blocks;
 
+struct hash_stream;
+
+/* Hash of the file being downloaded, or NULL if none */
+extern struct hash_stream *net_load_hash;
+
+#if CONFIG_IS_ENABLED(NET_LOAD_HASH)
+
+/**
+ * net_load_hash_start() - Start hashing a file which is being downloaded
+ *
+ * If the 'loadhash' environment variable names a hash algorithm, this sets
+ * up @net_load_hash so that the data is hashed as it arrives. Any previous
+ * hash is dropped and 'filehash' is cleared.
+ */
+void net_load_hash_start(void);
+
+/**
+ * net_load_hash_finish() - Finish hashing a downloaded file
+ *
+ * If all @size bytes were hashed, this sets 'filehash' to the digest.
+ * Otherwise the hash is dropped.
+ *
+ * @size: Size of the file, or 0 if the download failed
+ */
+void net_load_hash_finish(ulong size);
+#else
+static inline void net_load_hash_start(void)
+{
+}
+
+static inline void net_load_hash_finish(ulong size)
+{
+}
+#endif
+
 /**
  * compute_ip_checksum() - Compute IP checksum
  *
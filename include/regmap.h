@@ -88,14 +88,19 @@ struct regmap_bus;
  *			which starts at this address, instead of finding the
  *			start from device tree.
  * @r_size:		Same as above for the range size
+ * @cache_regs:		Number of registers to cache, starting at offset 0, or 0
+ *			for no cache. See regmap_init_cache()
  */
 struct regmap_config {
 	enum regmap_size_t width;
 	u32 reg_offset_shift;
 	ulong r_start;
 	ulong r_size;
+	uint cache_regs;
 };
 
+struct regmap_cache;
+
 /**
  * struct regmap - a way of accessing hardware/bus registers
  *
@@ -103,6 +108,10 @@ struct regmap_config {
  *			REGMAP_SIZE_32 if set to 0.
  * @reg_offset_shift	Left shift the register offset by this value before
  *			performing read or write.
+ * @fast_path:		true if regmap_read() and regmap_write() can access the
+ *			first range directly, i.e. the map is 32-bit and
+ *			native-endian, with no offset shift
+ * @cache:		Register cache, or NULL if none
  * @range_count:	Number of ranges available within the map
  * @ranges:		Array of ranges
  */
@@ -110,6 +119,8 @@ struct regmap {
 	enum regmap_endianness_t endianness;
 	enum regmap_size_t width;
 	u32 reg_offset_shift;
+	bool fast_path;
+	struct regmap_cache *cache;
 	int range_count;
 	struct regmap_range ranges[0];
 };
@@ -210,6 +221,35 @@ int regmap_raw_write_range(struct regmap *map, uint range_num, uint offset,
 int regmap_raw_read_range(struct regmap *map, uint range_num, uint offset,
 			  void *valp, size_t val_len);
 
+/**
+ * regmap_bulk_read() - Read a number of consecutive registers from a regmap
+ * @map:	Regmap to read from
+ * @offset:	Offset of the first register to read
+ * @val:	Buffer for the values, each of the map's width
+ * @count:	Number of registers to read
+ *
+ * For a 32-bit native-endian map with no offset shift, this maps the whole
+ * block once and reads it with one 32-bit access per register. Otherwise it is
+ * the same as calling regmap_raw_read() for each register.
+ *
+ * Return: 0 if OK, -ve on error
+ */
+int regmap_bulk_read(struct regmap *map, uint offset, void *val, size_t count);
+
+/**
+ * regmap_bulk_write() - Write a number of consecutive registers in a regmap
+ * @map:	Regmap to write to
+ * @offset:	Offset of the first register to write
+ * @val:	Values to write, each of the map's width
+ * @count:	Number of registers to write
+ *
+ * This is the write counterpart of regmap_bulk_read().
+ *
+ * Return: 0 if OK, -ve on error
+ */
+int regmap_bulk_write(struct regmap *map, uint offset, const void *val,
+		      size_t count);
+
 /**
  * regmap_range_set() - Set a value in a regmap range described by a struct
  * @map:    Regmap in which a value should be set
@@ -465,6 +505,36 @@ struct regmap *devm_regmap_init(struct udevice *dev,
  */
 void *regmap_get_range(struct regmap *map, unsigned int range_num);
 
+/**
+ * regmap_init_cache() - Cache the values of a regmap's registers
+ *
+ * This keeps the value of registers which are read or written through
+ * regmap_read(), regmap_write() and regmap_update_bits(). Later reads come
+ * from the cache, and regmap_update_bits() skips the write if the value does
+ * not change. This suits configuration registers which are written often but
+ * which the hardware never changes by itself. Do not use it for status
+ * registers.
+ *
+ * Writes with regmap_raw_write() and regmap_bulk_write() are always sent to
+ * the hardware and drop the affected registers from the cache.
+ *
+ * @map:	Regmap to update
+ * @count:	Number of registers to cache, starting at offset 0. Use 0 to
+ *		remove the cache
+ * Return: 0 if OK, -ENOMEM if out of memory
+ */
+int regmap_init_cache(struct regmap *map, uint count);
+
+/**
+ * regmap_cache_drop() - Drop all values from a regmap's cache
+ *
+ * Use this when the hardware may have changed its registers, e.g. after a
+ * reset, so that the next read of each register goes to the hardware.
+ *
+ * @map:	Regmap to update
+ */
+void regmap_cache_drop(struct regmap *map);
+
 /**
  * regmap_uninit() - free a previously inited regmap
  *
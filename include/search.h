@@ -47,6 +47,11 @@ struct hsearch_data {
 	struct env_entry_node *table;
 	unsigned int size;
 	unsigned int filled;
+	/* Bitmap of table slots changed since hclean_r() */
+	ulong *dirty;
+	/* Entries in order of key, used by hexport_r() */
+	struct env_entry **sorted;
+	bool sorted_ok;
 /*
  * Callback function which will check whether the given change for variable
  * "item" to "newval" may be applied or not, and possibly apply such change.
@@ -107,6 +112,22 @@ int himport_r(struct hsearch_data *htab, const char *env, size_t size,
 int hwalk_r(struct hsearch_data *htab,
 	    int (*callback)(struct env_entry *entry));
 
+/**
+ * hdirty_r() - Check whether a hash table changed
+ *
+ * @htab: Hash table
+ * Return: true if any entry was added, changed or deleted since the table was
+ *	created or hclean_r() was last called
+ */
+bool hdirty_r(struct hsearch_data *htab);
+
+/**
+ * hclean_r() - Forget about changes to a hash table
+ *
+ * @htab: Hash table
+ */
+void hclean_r(struct hsearch_data *htab);
+
 /* Flags for himport_r(), hexport_r(), hdelete_r(), and hsearch_r() */
 #define H_NOCLEAR	(1 << 0) /* do not clear hash table before importing */
 #define H_FORCE		(1 << 1) /* overwrite read-only/write-once variables */
@@ -123,5 +144,6 @@ int hwalk_r(struct hsearch_data *htab,
 #define H_ORIGIN_FLAGS	(H_INTERACTIVE | H_PROGRAMMATIC)
 #define H_DEFAULT	(1 << 10) /* indicate that an import is default env */
 #define H_EXTERNAL	(1 << 11) /* indicate that an import is external env */
+#define H_DEFER		(1 << 12) /* check new entries when import is done */
 
 #endif /* _SEARCH_H_ */
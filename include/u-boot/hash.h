@@ -5,6 +5,10 @@
 #ifndef _UBOOT_HASH_H
 #define _UBOOT_HASH_H
 
+#include <linux/types.h>
+
+struct udevice;
+
 enum HASH_ALGO {
 	HASH_ALGO_CRC16_CCITT,
 	HASH_ALGO_CRC32,
@@ -24,6 +28,57 @@ enum HASH_ALGO hash_algo_lookup_by_name(const char *name);
 ssize_t hash_algo_digest_size(enum HASH_ALGO algo);
 const char *hash_algo_name(enum HASH_ALGO algo);
 
+/**
+ * struct hash_uc_plat - uclass platform data for a hash device
+ *
+ * @algos: Bitmap of supported algorithms, BIT(HASH_ALGO_...), or 0 if the
+ *	driver does not say, in which case any algorithm may be tried
+ * @measured: Bitmap of algorithms for which @min_size is known
+ * @disabled: Bitmap of algorithms for which the device is never used, because
+ *	it was not faster than the CPU for any size measured, or failed
+ * @min_size: Smallest input worth giving to this device, for each algorithm.
+ *	Smaller inputs are hashed on the CPU. This comes from the
+ *	"u-boot,hash-min-size" property or is measured by
+ *	hash_measure_min_size()
+ * @cpu: true if the device hashes on the CPU, so is never used as an engine
+ */
+struct hash_uc_plat {
+	u32 algos;
+	u32 measured;
+	u32 disabled;
+	ulong min_size[HASH_ALGO_NUM];
+	bool cpu;
+};
+
+/**
+ * hash_find_device() - Find a hash engine to use for some data
+ *
+ * This looks through the hash devices in order for the first one which is not
+ * the CPU, supports @algo and is worth using for @size bytes. If a device
+ * has no minimum size yet, it is measured with CONFIG_DM_HASH_MEASURE and
+ * otherwise used for any size.
+ *
+ * @algo: Algorithm to use
+ * @size: Number of bytes to be hashed, or ULONG_MAX if not known
+ * @devp: Returns the device found
+ * Return: 0 if OK, -ENODEV if the data is best hashed on the CPU
+ */
+int hash_find_device(enum HASH_ALGO algo, ulong size, struct udevice **devp);
+
+/**
+ * hash_measure_min_size() - Work out when a hash engine is faster than the CPU
+ *
+ * This times the engine and the software implementation of @algo on inputs of
+ * increasing size, and sets the device's minimum size for @algo to the first
+ * one where the engine is faster. If it never is, or the engine fails, it is
+ * not used for @algo again.
+ *
+ * @dev: Hash device to measure
+ * @algo: Algorithm to measure with
+ * Return: 0 if OK, -ve on error
+ */
+int hash_measure_min_size(struct udevice *dev, enum HASH_ALGO algo);
+
 /* device-dependent APIs */
 int hash_digest(struct udevice *dev, enum HASH_ALGO algo,
 		const void *ibuf, const uint32_t ilen,
@@ -46,4 +46,32 @@ void sha384_finish(sha512_context * ctx, uint8_t digest[SHA384_SUM_LEN]);
 void sha384_csum_wd(const unsigned char *input, unsigned int ilen,
 		unsigned char *output, unsigned int chunk_sz);
 
+#if !CONFIG_IS_ENABLED(MBEDTLS_LIB_CRYPTO)
+/**
+ * sha512_process() - Hash a number of whole blocks
+ *
+ * This is used for both SHA-384 and SHA-512. It is weak so that an
+ * architecture can provide an accelerated version.
+ *
+ * @ctx: Context to update
+ * @data: Data to hash
+ * @blocks: Number of SHA512_BLOCK_SIZE blocks in @data
+ */
+void sha512_process(sha512_context *ctx, const uint8_t *data,
+		    unsigned int blocks);
+
+/**
+ * sha512_process_generic() - Hash a number of whole blocks in portable C
+ *
+ * An accelerated sha512_process() can fall back to this if the CPU does
+ * not support it.
+ *
+ * @ctx: Context to update
+ * @data: Data to hash
+ * @blocks: Number of SHA512_BLOCK_SIZE blocks in @data
+ */
+void sha512_process_generic(sha512_context *ctx, const uint8_t *data,
+			    unsigned int blocks);
+#endif
+
 #endif /* _SHA512_H */
@@ -109,6 +109,18 @@ void aes_cbc_encrypt_blocks(u32 key_size, u8 *key_exp, u8 *iv, u8 *src, u8 *dst,
 void aes_cbc_decrypt_blocks(u32 key_size, u8 *key_exp, u8 *iv, u8 *src, u8 *dst,
 			    u32 num_aes_blocks);
 
+/**
+ * aes_arch_cbc_decrypt_blocks() - Decrypt AES CBC blocks using CPU features
+ *
+ * This is called by aes_cbc_decrypt_blocks() and is weak so that an
+ * architecture can provide a faster version. It takes the same arguments.
+ *
+ * Return: 0 if OK, -ENOSYS if the CPU cannot do this, so that the portable
+ * code should be used
+ */
+int aes_arch_cbc_decrypt_blocks(u32 key_size, u8 *key_exp, u8 *iv, u8 *src,
+				u8 *dst, u32 num_aes_blocks);
+
 /* An AES block filled with zeros */
 static const u8 AES_ZERO_BLOCK[AES_BLOCK_LENGTH] = { 0 };
 struct udevice;
@@ -101,6 +101,13 @@ int uthread_create(struct uthread *uthr, void (*fn)(void *), void *arg,
  * Return: true if a thread was scheduled, false if no runnable thread was found
  */
 bool uthread_schedule(void);
+/**
+ * uthread_self() - get the thread which is currently running
+ *
+ * Return: the current thread, which is the main thread when no secondary
+ * thread is running
+ */
+struct uthread *uthread_self(void);
 /**
  * uthread_grp_new_id() - return a new ID for a thread group
  *
@@ -169,6 +176,11 @@ static inline bool uthread_schedule(void)
 	return false;
 }
 
+static inline struct uthread *uthread_self(void)
+{
+	return NULL;
+}
+
 static inline unsigned int uthread_grp_new_id(void)
 {
 	return 0;
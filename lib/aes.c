@@ -659,6 +659,12 @@ void aes_cbc_encrypt_blocks(u32 key_len, u8 *key_exp, u8 *iv, u8 *src, u8 *dst,
 	}
 }
 
+__weak int aes_arch_cbc_decrypt_blocks(u32 key_len, u8 *key_exp, u8 *iv,
+				       u8 *src, u8 *dst, u32 num_aes_blocks)
+{
+	return -ENOSYS;
+}
+
 void aes_cbc_decrypt_blocks(u32 key_len, u8 *key_exp, u8 *iv, u8 *src, u8 *dst,
 			    u32 num_aes_blocks)
 {
@@ -667,6 +673,10 @@ void aes_cbc_decrypt_blocks(u32 key_len, u8 *key_exp, u8 *iv, u8 *src, u8 *dst,
 	u8 cbc_chain_data[AES_BLOCK_LENGTH];
 	u32 i;
 
+	if (!aes_arch_cbc_decrypt_blocks(key_len, key_exp, iv, src, dst,
+					 num_aes_blocks))
+		return;
+
 	memcpy(cbc_chain_data, iv, AES_BLOCK_LENGTH);
 	for (i = 0; i < num_aes_blocks; i++) {
 		debug("encrypt_object: block %d of %d\n", i, num_aes_blocks);
@@ -175,6 +175,35 @@ const uint32_t * ZEXPORT get_crc_table()
 #  define DO_CRC(x) crc = tab[((crc >> 24) ^ (x)) & 255] ^ (crc << 8)
 # endif
 
+#if defined(CONFIG_RISCV_ISA_ZBC) && !defined(USE_HOSTCC)
+/*
+ * Fold one register of data into the CRC with carry-less multiplication,
+ * using Barrett reduction. The quotient floor(x^(XLEN + 32) / P) and the
+ * polynomial are bit-reflected, to match the table above.
+ */
+#if __riscv_xlen == 64
+#define CRC32_ZBC_QT	0x5a72d812fb808b20UL
+#define CRC32_ZBC_POLY	(0xedb88320UL << 32)
+#else
+#define CRC32_ZBC_QT	0xfb808b20UL
+#define CRC32_ZBC_POLY	0xedb88320UL
+#endif
+
+static inline uint32_t __efi_runtime crc32_zbc(uint32_t crc, unsigned long val)
+{
+	unsigned long s = crc ^ val, t;
+
+	asm ("clmul	%0, %1, %2\n"
+	     "slli	%0, %0, 1\n"
+	     "xor	%0, %0, %1\n"
+	     "clmulr	%0, %0, %3\n"
+	     : "=&r" (t)
+	     : "r" (s), "r" (CRC32_ZBC_QT), "r" (CRC32_ZBC_POLY));
+
+	return t >> (__riscv_xlen - 32);
+}
+#endif
+
 /* ========================================================================= */
 
 /* No ones complement version. JFFS2 (and other things ?)
@@ -187,6 +216,23 @@ uint32_t __efi_runtime crc32_no_comp(uint32_t crc, const Bytef *buf, uInt len)
     while (len--)
         crc = __builtin_aarch64_crc32b(crc, *buf++);
     return le32_to_cpu(crc);
+#elif defined(CONFIG_RISCV_ISA_ZBC) && !defined(USE_HOSTCC)
+    const uint32_t *tab = crc_table;
+    const unsigned long *b;
+#ifdef CONFIG_DYNAMIC_CRC_TABLE
+    if (crc_table_empty)
+      make_crc_table();
+#endif
+
+    for (; len && ((long)buf & (sizeof(long) - 1)); len--)
+	 DO_CRC(*buf++);
+    for (b = (const unsigned long *)buf; len >= sizeof(long);
+	 len -= sizeof(long))
+	 crc = crc32_zbc(crc, *b++);
+    for (buf = (const Bytef *)b; len; len--)
+	 DO_CRC(*buf++);
+
+    return crc;
 #else
     const uint32_t *tab = crc_table;
     const uint32_t *b =(const uint32_t *)buf;
@@ -30,6 +30,7 @@
 #  endif
 # endif
 #else				/* U-Boot build */
+# include <linux/bitops.h>
 # include <linux/string.h>
 # include <linux/ctype.h>
 #endif
@@ -55,12 +56,21 @@
 
 struct env_entry_node {
 	int used;
+	bool deferred;		/* added with H_DEFER and not checked yet */
 	struct env_entry entry;
 };
 
 static void _hdelete(const char *key, struct hsearch_data *htab,
 		     struct env_entry *ep, int idx);
 
+/* Record that a table slot changed, and whether the order of keys did */
+static void hmark_dirty(struct hsearch_data *htab, int idx, bool keys)
+{
+	htab->dirty[BIT_WORD(idx)] |= BIT_MASK(idx);
+	if (keys)
+		htab->sorted_ok = false;
+}
+
 /*
  * hcreate()
  */
@@ -117,11 +127,22 @@ int hcreate_r(size_t nel, struct hsearch_data *htab)
 	/* allocate memory and zero out */
 	htab->table = (struct env_entry_node *)calloc(htab->size + 1,
 						sizeof(struct env_entry_node));
-	if (htab->table == NULL) {
+	htab->dirty = calloc(BITS_TO_LONGS(htab->size + 1), sizeof(ulong));
+	if (htab->table == NULL || htab->dirty == NULL) {
+		free(htab->table);
+		free(htab->dirty);
+		htab->table = NULL;
+		htab->dirty = NULL;
 		__set_errno(ENOMEM);
 		return 0;
 	}
 
+	/*
+	 * A new table is a change in itself, even if nothing is added to it.
+	 * Slot zero never holds an entry, so use that to record it.
+	 */
+	hmark_dirty(htab, 0, true);
+
 	/* everything went alright */
 	return 1;
 }
@@ -155,6 +176,11 @@ void hdestroy_r(struct hsearch_data *htab)
 		}
 	}
 	free(htab->table);
+	free(htab->dirty);
+	free(htab->sorted);
+	htab->dirty = NULL;
+	htab->sorted = NULL;
+	htab->sorted_ok = false;
 
 	/* the sign for an existing table is an value != NULL in htable */
 	htab->table = NULL;
@@ -262,8 +288,11 @@ static inline int _compare_and_overwrite_entry(struct env_entry item,
 	    && strcmp(item.key, htab->table[idx].entry.key) == 0) {
 		/* Overwrite existing value? */
 		if (action == ENV_ENTER && item.data) {
+			/* A deferred entry is checked when the import is done */
+			bool check = !htab->table[idx].deferred;
+
 			/* check for permission */
-			if (htab->change_ok != NULL && htab->change_ok(
+			if (check && htab->change_ok != NULL && htab->change_ok(
 			    &htab->table[idx].entry, item.data,
 			    env_op_overwrite, flag)) {
 				debug("change_ok() rejected setting variable "
@@ -274,8 +303,9 @@ static inline int _compare_and_overwrite_entry(struct env_entry item,
 			}
 
 			/* If there is a callback, call it */
-			if (do_callback(&htab->table[idx].entry, item.key,
-					item.data, env_op_overwrite, flag)) {
+			if (check && do_callback(&htab->table[idx].entry,
+						 item.key, item.data,
+						 env_op_overwrite, flag)) {
 				debug("callback() rejected setting variable "
 					"%s, skipping it!\n", item.key);
 				__set_errno(EINVAL);
@@ -285,6 +315,7 @@ static inline int _compare_and_overwrite_entry(struct env_entry item,
 
 			free(htab->table[idx].entry.data);
 			htab->table[idx].entry.data = strdup(item.data);
+			hmark_dirty(htab, idx, false);
 			if (!htab->table[idx].entry.data) {
 				__set_errno(ENOMEM);
 				*retval = NULL;
@@ -409,6 +440,17 @@ int hsearch_r(struct env_entry item, enum env_action action,
 		}
 
 		++htab->filled;
+		hmark_dirty(htab, idx, true);
+
+		/*
+		 * When importing, new entries are checked once all of them are
+		 * present, by himport_finish()
+		 */
+		if (flag & H_DEFER) {
+			htab->table[idx].deferred = true;
+			*retval = &htab->table[idx].entry;
+			return 1;
+		}
 
 		/* This is a new entry, so look up a possible callback */
 		env_callback_init(&htab->table[idx].entry);
@@ -466,6 +508,8 @@ static void _hdelete(const char *key, struct hsearch_data *htab,
 	free(ep->data);
 	ep->flags = 0;
 	htab->table[idx].used = USED_DELETED;
+	htab->table[idx].deferred = false;
+	hmark_dirty(htab, idx, true);
 
 	--htab->filled;
 }
@@ -559,6 +603,32 @@ static int cmpkey(const void *p1, const void *p2)
 	return (strcmp(e1->key, e2->key));
 }
 
+/*
+ * Get all entries in order of key. The order is kept until an entry is added
+ * or deleted, so an export after only values have changed needs no sorting.
+ */
+static struct env_entry **hexport_sorted(struct hsearch_data *htab)
+{
+	int i, n;
+
+	if (htab->sorted_ok)
+		return htab->sorted;
+
+	if (!htab->sorted) {
+		htab->sorted = malloc(htab->size * sizeof(struct env_entry *));
+		if (!htab->sorted)
+			return NULL;
+	}
+	for (i = 1, n = 0; i <= htab->size; ++i) {
+		if (htab->table[i].used > 0)
+			htab->sorted[n++] = &htab->table[i].entry;
+	}
+	qsort(htab->sorted, n, sizeof(struct env_entry *), cmpkey);
+	htab->sorted_ok = true;
+
+	return htab->sorted;
+}
+
 static int match_string(int flag, const char *str, const char *pat, void *priv)
 {
 	switch (flag & H_MATCH_METHOD) {
@@ -622,6 +692,7 @@ ssize_t hexport_r(struct hsearch_data *htab, const char sep, int flag,
 		 int argc, char *const argv[])
 {
 	struct env_entry *list[htab->size];
+	struct env_entry **sorted;
 	char *res, *p;
 	size_t totlen;
 	int i, n;
@@ -634,56 +705,48 @@ ssize_t hexport_r(struct hsearch_data *htab, const char sep, int flag,
 
 	debug("EXPORT  table = %p, htab.size = %d, htab.filled = %d, size = %lu\n",
 	      htab, htab->size, htab->filled, (ulong)size);
+
+	sorted = hexport_sorted(htab);
+	if (!sorted && htab->filled) {
+		__set_errno(ENOMEM);
+		return (-1);
+	}
+
 	/*
 	 * Pass 1:
-	 * search used entries,
+	 * search used entries in order of key,
 	 * save addresses and compute total length
 	 */
-	for (i = 1, n = 0, totlen = 0; i <= htab->size; ++i) {
+	for (i = 0, n = 0, totlen = 0; i < htab->filled; ++i) {
+		struct env_entry *ep = sorted[i];
+		int found = match_entry(ep, flag, argc, argv);
 
-		if (htab->table[i].used > 0) {
-			struct env_entry *ep = &htab->table[i].entry;
-			int found = match_entry(ep, flag, argc, argv);
-
-			if ((argc > 0) && (found == 0))
-				continue;
+		if ((argc > 0) && (found == 0))
+			continue;
 
-			if ((flag & H_HIDE_DOT) && ep->key[0] == '.')
-				continue;
+		if ((flag & H_HIDE_DOT) && ep->key[0] == '.')
+			continue;
 
-			list[n++] = ep;
+		list[n++] = ep;
 
-			totlen += strlen(ep->key);
+		totlen += strlen(ep->key);
 
-			if (sep == '\0') {
-				totlen += strlen(ep->data);
-			} else {	/* check if escapes are needed */
-				char *s = ep->data;
+		if (sep == '\0') {
+			totlen += strlen(ep->data);
+		} else {	/* check if escapes are needed */
+			char *s = ep->data;
 
-				while (*s) {
+			while (*s) {
+				++totlen;
+				/* add room for needed escape chars */
+				if ((*s == sep) || (*s == '\\'))
 					++totlen;
-					/* add room for needed escape chars */
-					if ((*s == sep) || (*s == '\\'))
-						++totlen;
-					++s;
-				}
+				++s;
 			}
-			totlen += 2;	/* for '=' and 'sep' char */
 		}
+		totlen += 2;	/* for '=' and 'sep' char */
 	}
 
-#ifdef DEBUG
-	/* Pass 1a: print unsorted list */
-	printf("Unsorted: n=%d\n", n);
-	for (i = 0; i < n; ++i) {
-		printf("\t%3d: %p ==> %-10s => %s\n",
-		       i, list[i], list[i]->key, list[i]->data);
-	}
-#endif
-
-	/* Sort list by keys */
-	qsort(list, n, sizeof(struct env_entry *), cmpkey);
-
 	/* Check if the user supplied buffer size is sufficient */
 	if (size) {
 		if (size < totlen + 1) {	/* provided buffer too small */
@@ -768,6 +831,62 @@ static int drop_var_from_set(const char *name, int nvars, char * vars[])
 	return res;
 }
 
+/* Count the "name=value" pairs to be imported, which may be a few too many */
+static int himport_count(const char *data, size_t size, const char sep)
+{
+	const char *p = data, *end = data + size;
+	int count = 0;
+
+	while (p < end && *p) {
+		count++;
+		while (p < end && *p && *p != sep)
+			p++;
+		p++;
+	}
+
+	return count;
+}
+
+/*
+ * Finish the entries added by an import with H_DEFER: look up their
+ * callbacks and flags, then check them and call the callbacks, as hsearch_r()
+ * does for each new entry. Since this happens once all of them are present,
+ * the callbacks see the whole of the imported environment.
+ */
+static void himport_finish(struct hsearch_data *htab, int flag)
+{
+	int i;
+
+	for (i = 1; i <= htab->size; ++i) {
+		struct env_entry_node *node = &htab->table[i];
+		struct env_entry *ep = &node->entry;
+
+		if (node->used <= 0 || !node->deferred)
+			continue;
+		node->deferred = false;
+
+		env_callback_init(ep);
+		env_flags_init(ep);
+
+		if (htab->change_ok != NULL &&
+		    htab->change_ok(ep, ep->data, env_op_create, flag)) {
+			debug("change_ok() rejected setting variable "
+				"%s, skipping it!\n", ep->key);
+		} else if (do_callback(ep, ep->key, ep->data, env_op_create,
+				       flag)) {
+			debug("callback() rejected setting variable "
+				"%s, skipping it!\n", ep->key);
+		} else {
+			continue;
+		}
+#if !IS_ENABLED(CONFIG_ENV_WRITEABLE_LIST)
+		printf("himport_r: can't insert \"%s=%s\" into hash table\n",
+		       ep->key, ep->data);
+#endif
+		_hdelete(ep->key, htab, ep, i);
+	}
+}
+
 /*
  * Import linearized data into hash table.
  *
@@ -804,6 +923,14 @@ static int drop_var_from_set(const char *name, int nvars, char * vars[])
  *
  * In theory, arbitrary separator characters can be used, but only
  * '\0' and '\n' have really been tested.
+ *
+ * New variables are checked, and their callbacks called, after all of
+ * them have been added, so that importing a large environment does not
+ * run these once per variable against a partly imported table. This is
+ * done in hash table slot order, not in the order of the variables in
+ * "env", so a callback sees every imported variable already set, and
+ * must not rely on being called before or after that of another
+ * variable.
  */
 
 int himport_r(struct hsearch_data *htab,
@@ -861,14 +988,20 @@ int himport_r(struct hsearch_data *htab,
 	 * environment size), so we clip it to a reasonable value.
 	 * On the other hand we need to add some more entries for free
 	 * space when importing very small buffers. Both boundaries can
-	 * be overwritten in the board config file if needed.
+	 * be overwritten in the board config file if needed. Whatever the
+	 * heuristics say, the table is made large enough to hold all of the
+	 * variables being imported while staying at most half full, so that
+	 * it does not need to be resized and lookups stay short.
 	 */
 
 	if (!htab->table) {
 		int nent = CONFIG_ENV_MIN_ENTRIES + size / 8;
+		int count = himport_count(data, size, sep);
 
 		if (nent > CONFIG_ENV_MAX_ENTRIES)
 			nent = CONFIG_ENV_MAX_ENTRIES;
+		if (nent < 2 * count)
+			nent = 2 * count;
 
 		debug("Create Hash Table: N=%d\n", nent);
 
@@ -944,6 +1077,7 @@ int himport_r(struct hsearch_data *htab,
 
 		if (*name == 0) {
 			debug("INSERT: unable to use an empty key\n");
+			himport_finish(htab, flag);
 			__set_errno(EINVAL);
 			free(data);
 			return 0;
@@ -957,7 +1091,7 @@ int himport_r(struct hsearch_data *htab,
 		e.key = name;
 		e.data = value;
 
-		hsearch_r(e, ENV_ENTER, &rv, htab, flag);
+		hsearch_r(e, ENV_ENTER, &rv, htab, flag | H_DEFER);
 #if !IS_ENABLED(CONFIG_ENV_WRITEABLE_LIST)
 		if (rv == NULL) {
 			printf("himport_r: can't insert \"%s=%s\" into hash table\n",
@@ -973,6 +1107,8 @@ int himport_r(struct hsearch_data *htab,
 	debug("INSERT: free(data = %p)\n", data);
 	free(data);
 
+	himport_finish(htab, flag);
+
 	if (flag & H_NOCLEAR)
 		goto end;
 
@@ -1022,3 +1158,24 @@ int hwalk_r(struct hsearch_data *htab, int (*callback)(struct env_entry *entry))
 
 	return 0;
 }
+
+bool hdirty_r(struct hsearch_data *htab)
+{
+	int i;
+
+	if (!htab->dirty)
+		return true;
+	for (i = 0; i < BITS_TO_LONGS(htab->size + 1); i++) {
+		if (htab->dirty[i])
+			return true;
+	}
+
+	return false;
+}
+
+void hclean_r(struct hsearch_data *htab)
+{
+	if (htab->dirty)
+		memset(htab->dirty, '\0',
+		       BITS_TO_LONGS(htab->size + 1) * sizeof(ulong));
+}
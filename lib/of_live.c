@@ -22,6 +22,9 @@
 
 enum {
 	BUF_STEP	= SZ_64K,
+
+	/* Maximum node depth handled by unflatten_dt_size() */
+	SIZE_MAX_DEPTH	= 32,
 };
 
 static void *unflatten_dt_alloc(void **mem, unsigned long size,
@@ -261,6 +264,68 @@ static void *unflatten_dt_node(const void *blob, void *mem, int *poffset,
 	return mem;
 }
 
+/**
+ * unflatten_dt_size() - Work out the memory needed to unflatten a tree
+ *
+ * This produces the same result as a dry run of unflatten_dt_node(), but
+ * walks the structure block tag by tag instead of looking up each property
+ * and its name, so it is much cheaper. Only the nodes and properties need
+ * space, since with version 0x10 and later trees the node name is taken from
+ * the unit name and no 'name' property is created.
+ *
+ * @blob: Device tree blob, version 0x10 or later
+ * Return: number of bytes needed, or 0 if the tree is too deep or invalid
+ */
+static unsigned long unflatten_dt_size(const void *blob)
+{
+	unsigned long fpsize[SIZE_MAX_DEPTH];
+	int offset, nextoffset;
+	void *mem = NULL;
+	int depth = -1;
+	uint32_t tag;
+
+	for (offset = 0; ; offset = nextoffset) {
+		const char *name;
+		unsigned long allocl;
+
+		tag = fdt_next_tag(blob, offset, &nextoffset);
+		switch (tag) {
+		case FDT_BEGIN_NODE:
+			if (++depth >= SIZE_MAX_DEPTH)
+				return 0;
+			if (!depth) {
+				/* see unflatten_dt_node() for the root node */
+				fpsize[depth] = 1;
+				allocl = 2;
+			} else {
+				name = fdt_offset_ptr(blob,
+						      offset + FDT_TAGSIZE, 1);
+				if (!name)
+					return 0;
+				fpsize[depth] = fpsize[depth - 1] +
+					strlen(name) + 1;
+				allocl = fpsize[depth];
+			}
+			unflatten_dt_alloc(&mem,
+					   sizeof(struct device_node) + allocl,
+					   __alignof__(struct device_node));
+			break;
+		case FDT_PROP:
+			unflatten_dt_alloc(&mem, sizeof(struct property),
+					   __alignof__(struct property));
+			break;
+		case FDT_END_NODE:
+			if (--depth < 0)
+				return (unsigned long)mem;
+			break;
+		case FDT_NOP:
+			break;
+		default:
+			return 0;
+		}
+	}
+}
+
 int unflatten_device_tree(const void *blob, struct device_node **mynodes)
 {
 	unsigned long size;
@@ -285,9 +350,14 @@ int unflatten_device_tree(const void *blob, struct device_node **mynodes)
 	}
 
 	/* First pass, scan for size */
-	start = 0;
-	size = (unsigned long)unflatten_dt_node(blob, NULL, &start, NULL, NULL,
-						0, true);
+	size = 0;
+	if (fdt_version(blob) >= 0x10)
+		size = unflatten_dt_size(blob);
+	if (!size) {
+		start = 0;
+		size = (unsigned long)unflatten_dt_node(blob, NULL, &start,
+							NULL, NULL, 0, true);
+	}
 	if (!size)
 		return -EFAULT;
 	size = ALIGN(size, 4);
@@ -6,6 +6,8 @@
 #ifndef USE_HOSTCC
 #include <fdtdec.h>
 #include <log.h>
+#include <malloc.h>
+#include <asm/global_data.h>
 #include <asm/types.h>
 #include <asm/byteorder.h>
 #include <linux/errno.h>
@@ -19,6 +21,10 @@
 #include <u-boot/rsa.h>
 #include <u-boot/rsa-mod-exp.h>
 
+#ifndef USE_HOSTCC
+DECLARE_GLOBAL_DATA_PTR;
+#endif
+
 #define UINT64_MULT32(v, multby)  (((uint64_t)(v)) * ((uint32_t)(multby)))
 
 #define get_unaligned_be32(a) fdt32_to_cpu(*(uint32_t *)a)
@@ -35,6 +41,18 @@ static inline uint64_t fdt64_to_cpup(const void *p)
 /* Default public exponent for backward compatibility */
 #define RSA_DEFAULT_PUBEXP	65537
 
+/*
+ * With a 64x64-bit multiply, Montgomery multiplication on 64-bit limbs needs a
+ * quarter of the multiply steps that it does on 32-bit limbs
+ */
+#ifdef __SIZEOF_INT128__
+#define RSA_MONT64
+typedef unsigned __int128 rsa_uint128_t;
+
+/* Number of keys kept between verifications */
+#define RSA_MONT64_CACHE_KEYS	4
+#endif
+
 /**
  * subtract_modulus() - subtract modulus from the given value
  *
@@ -134,17 +152,14 @@ static void montgomery_mul(const struct rsa_public_key *key,
 /**
  * num_pub_exponent_bits() - Number of bits in the public exponent
  *
- * @key:	RSA key
+ * @exponent:	Public exponent
  * @num_bits:	Storage for the number of public exponent bits
  */
-static int num_public_exponent_bits(const struct rsa_public_key *key,
-		int *num_bits)
+static int num_public_exponent_bits(uint64_t exponent, int *num_bits)
 {
-	uint64_t exponent;
 	int exponent_bits;
 	const uint max_bits = (sizeof(exponent) * 8);
 
-	exponent = key->exponent;
 	exponent_bits = 0;
 
 	if (!exponent) {
@@ -164,13 +179,41 @@ static int num_public_exponent_bits(const struct rsa_public_key *key,
 /**
  * is_public_exponent_bit_set() - Check if a bit in the public exponent is set
  *
- * @key:	RSA key
+ * @exponent:	Public exponent
  * @pos:	The bit position to check
  */
-static int is_public_exponent_bit_set(const struct rsa_public_key *key,
-		int pos)
+static int is_public_exponent_bit_set(uint64_t exponent, int pos)
 {
-	return key->exponent & (1ULL << pos);
+	return exponent & (1ULL << pos);
+}
+
+/**
+ * check_public_exponent() - Check that a public exponent can be used
+ *
+ * @exponent:	Public exponent
+ * @num_bits:	Storage for the number of public exponent bits
+ * Return: 0 if OK, -EINVAL if not
+ */
+static int check_public_exponent(uint64_t exponent, int *num_bits)
+{
+	int k;
+
+	if (0 != num_public_exponent_bits(exponent, &k))
+		return -EINVAL;
+
+	if (k < 2) {
+		debug("Public exponent is too short (%d bits, minimum 2)\n",
+		      k);
+		return -EINVAL;
+	}
+
+	if (!is_public_exponent_bit_set(exponent, 0)) {
+		debug("LSB of RSA public exponent must be set.\n");
+		return -EINVAL;
+	}
+	*num_bits = k;
+
+	return 0;
 }
 
 /**
@@ -200,19 +243,8 @@ static int pow_mod(const struct rsa_public_key *key, uint32_t *inout)
 	for (i = 0, ptr = inout + key->len - 1; i < key->len; i++, ptr--)
 		val[i] = get_unaligned_be32(ptr);
 
-	if (0 != num_public_exponent_bits(key, &k))
-		return -EINVAL;
-
-	if (k < 2) {
-		debug("Public exponent is too short (%d bits, minimum 2)\n",
-		      k);
-		return -EINVAL;
-	}
-
-	if (!is_public_exponent_bit_set(key, 0)) {
-		debug("LSB of RSA public exponent must be set.\n");
+	if (check_public_exponent(key->exponent, &k))
 		return -EINVAL;
-	}
 
 	/* the bit at e[k-1] is 1 by definition, so start with: C := M */
 	montgomery_mul(key, acc, val, key->rr); /* acc = a * RR / R mod n */
@@ -222,7 +254,7 @@ static int pow_mod(const struct rsa_public_key *key, uint32_t *inout)
 	for (j = k - 2; j > 0; --j) {
 		montgomery_mul(key, tmp, acc, acc); /* tmp = acc^2 / R mod n */
 
-		if (is_public_exponent_bit_set(key, j)) {
+		if (is_public_exponent_bit_set(key->exponent, j)) {
 			/* acc = tmp * val / R mod n */
 			montgomery_mul(key, acc, tmp, a_scaled);
 		} else {
@@ -246,6 +278,263 @@ static int pow_mod(const struct rsa_public_key *key, uint32_t *inout)
 	return 0;
 }
 
+#ifdef RSA_MONT64
+/**
+ * struct rsa_mont64_key - RSA public key with 64-bit limbs
+ *
+ * This holds everything derived from a key which pow_mod64() needs, so that
+ * it can be kept between verifications with the same key.
+ *
+ * @len:	len of modulus[] and rr[] in number of uint64_t
+ * @n0inv:	-1 / modulus[0] mod 2^64
+ * @exponent:	public exponent
+ * @modulus:	modulus as little endian array
+ * @rr:		R^2 as little endian array
+ * @data:	space for modulus[] and rr[] in a key which is kept
+ */
+struct rsa_mont64_key {
+	uint len;
+	uint64_t n0inv;
+	uint64_t exponent;
+	uint64_t *modulus;
+	uint64_t *rr;
+	uint64_t data[];
+};
+
+/* Keys kept by rsa_mont64_get_key(), replaced in turn */
+static struct rsa_mont64_key *rsa_mont64_cache[RSA_MONT64_CACHE_KEYS];
+static uint rsa_mont64_cache_next;
+
+static void subtract_modulus64(const struct rsa_mont64_key *key,
+			       uint64_t num[])
+{
+	uint64_t borrow = 0, val;
+	uint i;
+
+	for (i = 0; i < key->len; i++) {
+		val = num[i] - key->modulus[i] - borrow;
+		borrow = num[i] < key->modulus[i] ||
+			 (num[i] == key->modulus[i] && borrow);
+		num[i] = val;
+	}
+}
+
+static int greater_equal_modulus64(const struct rsa_mont64_key *key,
+				   uint64_t num[])
+{
+	int i;
+
+	for (i = (int)key->len - 1; i >= 0; i--) {
+		if (num[i] < key->modulus[i])
+			return 0;
+		if (num[i] > key->modulus[i])
+			return 1;
+	}
+
+	return 1;  /* equal */
+}
+
+/* As montgomery_mul_add_step(), with 64-bit limbs */
+static void montgomery_mul_add_step64(const struct rsa_mont64_key *key,
+		uint64_t result[], const uint64_t a, const uint64_t b[])
+{
+	rsa_uint128_t acc_a, acc_b;
+	uint64_t d0;
+	uint i;
+
+	acc_a = (rsa_uint128_t)a * b[0] + result[0];
+	d0 = (uint64_t)acc_a * key->n0inv;
+	acc_b = (rsa_uint128_t)d0 * key->modulus[0] + (uint64_t)acc_a;
+	for (i = 1; i < key->len; i++) {
+		acc_a = (acc_a >> 64) + (rsa_uint128_t)a * b[i] + result[i];
+		acc_b = (acc_b >> 64) + (rsa_uint128_t)d0 * key->modulus[i] +
+				(uint64_t)acc_a;
+		result[i - 1] = (uint64_t)acc_b;
+	}
+
+	acc_a = (acc_a >> 64) + (acc_b >> 64);
+
+	result[i - 1] = (uint64_t)acc_a;
+
+	if (acc_a >> 64)
+		subtract_modulus64(key, result);
+}
+
+static void montgomery_mul64(const struct rsa_mont64_key *key,
+		uint64_t result[], uint64_t a[], const uint64_t b[])
+{
+	uint i;
+
+	for (i = 0; i < key->len; ++i)
+		result[i] = 0;
+	for (i = 0; i < key->len; ++i)
+		montgomery_mul_add_step64(key, result, a[i], b);
+}
+
+/**
+ * pow_mod64() - public exponentiation with 64-bit limbs
+ *
+ * @in and @out may be the same buffer.
+ *
+ * @key:	RSA key
+ * @in:		Big-endian byte array containing value
+ * @out:	Big-endian byte array to hold the result
+ */
+static int pow_mod64(const struct rsa_mont64_key *key, const uint8_t *in,
+		     uint8_t *out)
+{
+	const uint8_t *src;
+	uint8_t *ptr;
+	fdt64_t w;
+	uint i;
+	int j, k;
+
+	/* Sanity check for stack size - key->len is in 64-bit words */
+	if (!key->len || key->len > RSA_MAX_KEY_BITS / 64) {
+		debug("RSA key words %u out of range\n", key->len);
+		return -EINVAL;
+	}
+	if (check_public_exponent(key->exponent, &k))
+		return -EINVAL;
+
+	uint64_t val[key->len], acc[key->len], tmp[key->len];
+	uint64_t a_scaled[key->len];
+
+	for (i = 0, src = in + (key->len - 1) * 8; i < key->len;
+	     i++, src -= 8)
+		val[i] = fdt64_to_cpup(src);
+
+	/* See pow_mod() for the steps */
+	montgomery_mul64(key, acc, val, key->rr);
+	memcpy(a_scaled, acc, key->len * sizeof(a_scaled[0]));
+
+	for (j = k - 2; j > 0; --j) {
+		montgomery_mul64(key, tmp, acc, acc);
+		if (is_public_exponent_bit_set(key->exponent, j))
+			montgomery_mul64(key, acc, tmp, a_scaled);
+		else
+			memcpy(acc, tmp, key->len * sizeof(acc[0]));
+	}
+
+	montgomery_mul64(key, tmp, acc, acc);
+	montgomery_mul64(key, acc, tmp, val);
+
+	if (greater_equal_modulus64(key, acc))
+		subtract_modulus64(key, acc);
+
+	for (i = key->len, ptr = out; i-- > 0; ptr += 8) {
+		w = cpu_to_fdt64(acc[i]);
+		memcpy(ptr, &w, sizeof(w));
+	}
+
+	return 0;
+}
+
+/**
+ * rsa_mont64_init_key() - Set up a key with 64-bit limbs
+ *
+ * @key:	Key to set up
+ * @data:	Space for the modulus and R^2, 2 * num_bits / 64 elements
+ * @prop:	Key properties, with num_bits a multiple of 64
+ * @exponent:	Public exponent
+ */
+static void rsa_mont64_init_key(struct rsa_mont64_key *key, uint64_t *data,
+				const struct key_prop *prop, uint64_t exponent)
+{
+	const uint8_t *mod = prop->modulus, *rr = prop->rr;
+	uint64_t inv;
+	uint i;
+
+	key->len = prop->num_bits / 64;
+	key->exponent = exponent;
+	key->modulus = data;
+	key->rr = data + key->len;
+	for (i = 0; i < key->len; i++) {
+		key->modulus[i] = fdt64_to_cpup(mod + (key->len - 1 - i) * 8);
+		key->rr[i] = fdt64_to_cpup(rr + (key->len - 1 - i) * 8);
+	}
+
+	/*
+	 * The modulus is odd, so it is its own inverse mod 8, and each Newton
+	 * step doubles the number of correct bits
+	 */
+	inv = key->modulus[0];
+	for (i = 0; i < 5; i++)
+		inv *= 2 - key->modulus[0] * inv;
+	key->n0inv = -inv;
+}
+
+/**
+ * rsa_mont64_key_matches() - Check whether a kept key is for the given key
+ *
+ * @key:	Kept key
+ * @prop:	Key properties, with num_bits a multiple of 64
+ * @exponent:	Public exponent
+ * Return: true if @key has the same modulus, R^2 and exponent
+ */
+static bool rsa_mont64_key_matches(const struct rsa_mont64_key *key,
+				   const struct key_prop *prop,
+				   uint64_t exponent)
+{
+	const uint8_t *mod = prop->modulus, *rr = prop->rr;
+	uint len = prop->num_bits / 64;
+	uint i;
+
+	if (key->len != len || key->exponent != exponent)
+		return false;
+	for (i = 0; i < len; i++) {
+		if (key->modulus[i] != fdt64_to_cpup(mod + (len - 1 - i) * 8) ||
+		    key->rr[i] != fdt64_to_cpup(rr + (len - 1 - i) * 8))
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * rsa_mont64_get_key() - Get a kept key with 64-bit limbs
+ *
+ * Keys are recognised by their full contents, not by where they are
+ * stored, since key properties may be freed and their memory reused. Nothing
+ * is kept until malloc() is fully available.
+ *
+ * @prop:	Key properties, with num_bits a multiple of 64
+ * @exponent:	Public exponent
+ * Return: key to use, or NULL if it cannot be kept
+ */
+static const struct rsa_mont64_key *
+rsa_mont64_get_key(const struct key_prop *prop, uint64_t exponent)
+{
+	struct rsa_mont64_key *key;
+	uint len = prop->num_bits / 64;
+	int i;
+
+#ifndef USE_HOSTCC
+	if (!(gd->flags & GD_FLG_FULL_MALLOC_INIT))
+		return NULL;
+#endif
+	for (i = 0; i < RSA_MONT64_CACHE_KEYS; i++) {
+		key = rsa_mont64_cache[i];
+		if (key && rsa_mont64_key_matches(key, prop, exponent))
+			return key;
+	}
+
+	i = rsa_mont64_cache_next;
+	key = rsa_mont64_cache[i];
+	if (!key || key->len != len) {
+		free(key);
+		key = malloc(sizeof(*key) + 2 * len * sizeof(uint64_t));
+		rsa_mont64_cache[i] = key;
+		if (!key)
+			return NULL;
+	}
+	rsa_mont64_cache_next = (i + 1) % RSA_MONT64_CACHE_KEYS;
+	rsa_mont64_init_key(key, key->data, prop, exponent);
+
+	return key;
+}
+#endif /* RSA_MONT64 */
+
 static void rsa_convert_big_endian(uint32_t *dst, const uint32_t *src, int len)
 {
 	int i;
@@ -283,6 +572,24 @@ int rsa_mod_exp_sw(const uint8_t *sig, uint32_t sig_len,
 		      key.len, RSA_MIN_KEY_BITS, RSA_MAX_KEY_BITS);
 		return -EFAULT;
 	}
+#ifdef RSA_MONT64
+	if (!(key.len % 64)) {
+		const struct rsa_mont64_key *key64;
+
+		if (sig_len != key.len / 8)
+			return -EINVAL;
+		key64 = rsa_mont64_get_key(prop, key.exponent);
+		if (!key64) {
+			struct rsa_mont64_key tmp;
+			uint64_t data[2 * key.len / 64];
+
+			rsa_mont64_init_key(&tmp, data, prop, key.exponent);
+			return pow_mod64(&tmp, sig, out);
+		}
+
+		return pow_mod64(key64, sig, out);
+	}
+#endif
 	key.len /= sizeof(uint32_t) * 8;
 	uint32_t key1[key.len], key2[key.len];
 
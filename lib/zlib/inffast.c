@@ -12,6 +12,31 @@
 
 #ifndef ASMINF
 
+/*
+   U-Boot: the bit buffer is refilled a word at a time where there is enough
+   input, so that on a 64-bit machine a whole length/distance pair can nearly
+   always be decoded after one refill.  This leaves part of the next input
+   byte above the valid bits in hold, which does no harm, since that byte is
+   later ORed into the same position.
+ */
+#define FAST_PULLBYTE() \
+    do { \
+        hold |= (unsigned long)(*in++) << bits; \
+        bits += 8; \
+    } while (0)
+
+#define FAST_REFILL() \
+    do { \
+        if (sizeof(hold) == 8 && in_end - in >= 8) { \
+            hold |= (unsigned long)get_unaligned_le64(in) << bits; \
+            in += (63 - bits) >> 3; \
+            bits |= 56; \
+        } else { \
+            FAST_PULLBYTE(); \
+            FAST_PULLBYTE(); \
+        } \
+    } while (0)
+
 /*
    Decode literal, length, and distance codes and write out the resulting
    literal and match bytes until either not enough input or output is
@@ -54,6 +79,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     struct inflate_state FAR *state;
     z_const unsigned char FAR *in;      /* local strm->next_in */
     z_const unsigned char FAR *last;    /* have enough input while in < last */
+    z_const unsigned char FAR *in_end;  /* end of the available input */
     unsigned char FAR *out;     /* local strm->next_out */
     unsigned char FAR *beg;     /* inflate()'s initial strm->next_out */
     unsigned char FAR *end;     /* while out < end, enough space available */
@@ -89,6 +115,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
 	strm->avail_in = 0xffffffff - (uintptr_t)in;
         last = in + (strm->avail_in - 5);
     }
+    in_end = last + 5;
     out = strm->next_out;
     beg = out - (start - strm->avail_out);
     end = out + (strm->avail_out - 257);
@@ -109,12 +136,8 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     /* decode literals and length/distances until end-of-block or not enough
        input data or output space */
     do {
-        if (bits < 15) {
-            hold += (unsigned long)(*in++) << bits;
-            bits += 8;
-            hold += (unsigned long)(*in++) << bits;
-            bits += 8;
-        }
+        if (bits < 15)
+            FAST_REFILL();
         here = lcode[hold & lmask];
       dolen:
         op = (unsigned)(here.bits);
@@ -131,21 +154,15 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
             len = (unsigned)(here.val);
             op &= 15;                           /* number of extra bits */
             if (op) {
-                if (bits < op) {
-                    hold += (unsigned long)(*in++) << bits;
-                    bits += 8;
-                }
+                if (bits < op)
+                    FAST_PULLBYTE();
                 len += (unsigned)hold & ((1U << op) - 1);
                 hold >>= op;
                 bits -= op;
             }
             Tracevv((stderr, "inflate:         length %u\n", len));
-            if (bits < 15) {
-                hold += (unsigned long)(*in++) << bits;
-                bits += 8;
-                hold += (unsigned long)(*in++) << bits;
-                bits += 8;
-            }
+            if (bits < 15)
+                FAST_REFILL();
             here = dcode[hold & dmask];
           dodist:
             op = (unsigned)(here.bits);
@@ -156,12 +173,9 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                 dist = (unsigned)(here.val);
                 op &= 15;                       /* number of extra bits */
                 if (bits < op) {
-                    hold += (unsigned long)(*in++) << bits;
-                    bits += 8;
-                    if (bits < op) {
-                        hold += (unsigned long)(*in++) << bits;
-                        bits += 8;
-                    }
+                    FAST_PULLBYTE();
+                    if (bits < op)
+                        FAST_PULLBYTE();
                 }
                 dist += (unsigned)hold & ((1U << op) - 1);
 #ifdef INFLATE_STRICT
@@ -235,6 +249,22 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                             *out++ = *from++;
                     }
                 }
+                else if (dist >= sizeof(unsigned long)) {
+                    /* U-Boot: the source and destination of each word do
+                       not overlap, so copy a word at a time */
+                    from = out - dist;          /* copy direct from output */
+                    while (len >= sizeof(unsigned long)) {
+                        put_unaligned(get_unaligned((unsigned long *)from),
+                                      (unsigned long *)out);
+                        out += sizeof(unsigned long);
+                        from += sizeof(unsigned long);
+                        len -= sizeof(unsigned long);
+                    }
+                    while (len) {
+                        *out++ = *from++;
+                        len--;
+                    }
+                }
                 else {
 		    unsigned short *sout;
 		    unsigned long loops;
@@ -309,7 +339,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
     len = bits >> 3;
     in -= len;
     bits -= len << 3;
-    hold &= (1U << bits) - 1;
+    hold &= (1UL << bits) - 1;
 
     /* update state and return */
     strm->next_in = in;
@@ -336,4 +366,7 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
    - Moving len -= 3 statement into middle of loop
  */
 
+#undef FAST_REFILL
+#undef FAST_PULLBYTE
+
 #endif /* !ASMINF */
@@ -8,15 +8,264 @@
 #include <abuf.h>
 #include <log.h>
 #include <malloc.h>
+#include <time.h>
+#include <asm/cache.h>
 #include <linux/errno.h>
+#include <linux/kernel.h>
 #include <linux/zstd.h>
+#if CONFIG_IS_ENABLED(ZSTD_PARALLEL)
+#include <asm/smp.h>
+#endif
+
+/**
+ * zstd_frames_size() - Find the size of the frames at the start of a buffer
+ *
+ * Any data after the last complete frame is ignored, since there may be junk
+ * after the frames which zstd_decompress_dctx() cannot handle.
+ *
+ * @in: Input buffer
+ * @countp: Returns the number of frames, including skippable frames
+ * Return: Total size of the frames, or a zstd error if there is no frame
+ */
+static size_t zstd_frames_size(struct abuf *in, int *countp)
+{
+	const char *data = abuf_data(in);
+	size_t size = abuf_size(in);
+	size_t pos, len;
+
+	*countp = 0;
+	for (pos = 0; pos < size; pos += len) {
+		len = zstd_find_frame_compressed_size(data + pos, size - pos);
+		if (zstd_is_error(len)) {
+			if (!pos)
+				return len;
+			break;
+		}
+		(*countp)++;
+	}
+
+	return pos;
+}
+
+#if CONFIG_IS_ENABLED(ZSTD_PARALLEL)
+/* Time to wait for other CPUs to return after all frames are done */
+#define ZSTD_PARALLEL_TIMEOUT_MS	1000
+
+/**
+ * struct zstd_frame - Location of a frame and its decompressed data
+ *
+ * @in: Start of the compressed frame
+ * @in_size: Size of the compressed frame in bytes
+ * @out: Place to put the decompressed data
+ * @out_size: Size of the decompressed data in bytes
+ */
+struct zstd_frame {
+	const void *in;
+	size_t in_size;
+	void *out;
+	size_t out_size;
+};
+
+/**
+ * struct zstd_job - Work shared between CPUs decompressing frames
+ *
+ * The fields which are updated by more than one CPU are only accessed with
+ * atomic operations.
+ *
+ * @frames: Frames to decompress
+ * @frame_count: Number of frames
+ * @workspace: Decompression workspaces, one for each other CPU taking part
+ * @wsize: Size of each workspace
+ * @next_slot: Next workspace to hand out
+ * @next_frame: Next frame to hand out
+ * @done: Number of frames finished
+ * @returned: Number of CPUs which have finished with the job
+ * @err: Set to a -ve error number if any frame failed
+ */
+struct zstd_job {
+	struct zstd_frame *frames;
+	int frame_count;
+	void *workspace;
+	size_t wsize;
+	int next_slot;
+	int next_frame;
+	int done;
+	int returned;
+	int err;
+};
+
+/**
+ * zstd_worker() - Decompress frames until there are none left
+ *
+ * This runs on each CPU taking part, including the one which set up the job.
+ * It must not allocate memory or print anything, since other CPUs may be
+ * doing the same. A CPU only takes a workspace once it has a frame to work on,
+ * so one which starts late does not touch anything but @job itself.
+ *
+ * @cpu: CPU number (unused)
+ * @arg: Pointer to struct zstd_job
+ * @arg1: Decompression context of the CPU which set up the job, or 0 to take
+ *	one of the job's workspaces
+ */
+static void zstd_worker(ulong cpu, ulong arg, ulong arg1)
+{
+	struct zstd_job *job = (struct zstd_job *)arg;
+	zstd_dctx *ctx = (zstd_dctx *)arg1;
+	struct zstd_frame *frame;
+	int slot = ctx ? 0 : -1;
+	size_t len;
+	int idx;
+
+	/*
+	 * Frame 0 is kept back for the CPU which set up the job, so at most
+	 * one workspace is needed for each of the other frames
+	 */
+	idx = ctx ? 0 : __atomic_fetch_add(&job->next_frame, 1,
+					   __ATOMIC_ACQ_REL);
+	for (; idx < job->frame_count;
+	     idx = __atomic_fetch_add(&job->next_frame, 1, __ATOMIC_ACQ_REL)) {
+		frame = &job->frames[idx];
+		if (slot == -1) {
+			slot = __atomic_fetch_add(&job->next_slot, 1,
+						  __ATOMIC_ACQ_REL);
+			ctx = zstd_init_dctx(job->workspace + slot * job->wsize,
+					     job->wsize);
+		}
+		if (ctx) {
+			len = zstd_decompress_dctx(ctx, frame->out,
+						   frame->out_size, frame->in,
+						   frame->in_size);
+			if (zstd_is_error(len) || len != frame->out_size)
+				__atomic_store_n(&job->err, -EINVAL,
+						 __ATOMIC_RELAXED);
+		} else {
+			__atomic_store_n(&job->err, -EPERM, __ATOMIC_RELAXED);
+		}
+		__atomic_fetch_add(&job->done, 1, __ATOMIC_RELEASE);
+	}
+	__atomic_fetch_add(&job->returned, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * zstd_decompress_parallel() - Decompress frames on all available CPUs
+ *
+ * Each frame must record its decompressed size, so that its output can be
+ * placed without decompressing the frames before it.
+ *
+ * @ctx: Decompression context to use on this CPU
+ * @in: Input buffer
+ * @out: Output buffer
+ * @count: Number of frames at the start of @in
+ * Return: size of the decompressed data, -ENOENT if the frames cannot be
+ *	decompressed separately, -ENOMEM if there is not enough memory to
+ *	set up the job, or other -ve on error. In the first two cases the
+ *	output is untouched.
+ */
+static int zstd_decompress_parallel(zstd_dctx *ctx, struct abuf *in,
+				    struct abuf *out, int count)
+{
+	const char *data = abuf_data(in);
+	char *dst = abuf_data(out);
+	size_t pos, opos, len;
+	struct zstd_job *job;
+	ulong start;
+	int i, cpus, extra, ret;
+
+	job = calloc(1, sizeof(*job));
+	if (!job)
+		return -ENOMEM;
+	job->frames = calloc(count, sizeof(struct zstd_frame));
+	if (!job->frames) {
+		ret = -ENOMEM;
+		goto err_job;
+	}
+
+	for (i = 0, pos = 0, opos = 0; i < count; pos += len) {
+		struct zstd_frame *frame = &job->frames[i];
+		zstd_frame_header hdr;
+
+		len = zstd_find_frame_compressed_size(data + pos,
+						      abuf_size(in) - pos);
+		if (zstd_get_frame_header(&hdr, data + pos, len) ||
+		    hdr.frameContentSize == ZSTD_CONTENTSIZE_UNKNOWN ||
+		    hdr.frameContentSize == ZSTD_CONTENTSIZE_ERROR ||
+		    hdr.frameContentSize > abuf_size(out) - opos) {
+			ret = -ENOENT;
+			goto err_frames;
+		}
+		if (hdr.frameType == ZSTD_skippableFrame) {
+			count--;
+			continue;
+		}
+		frame->in = data + pos;
+		frame->in_size = len;
+		frame->out = dst + opos;
+		frame->out_size = hdr.frameContentSize;
+		opos += frame->out_size;
+		i++;
+	}
+	if (count < 2) {
+		ret = -ENOENT;
+		goto err_frames;
+	}
+	job->frame_count = count;
+	job->next_frame = 1;
+
+	/*
+	 * This CPU uses @ctx, so allow a workspace for each other CPU, up to
+	 * the number of frames which are left for them
+	 */
+	extra = min(count, CONFIG_NR_CPUS) - 1;
+	job->wsize = ALIGN(zstd_dctx_workspace_bound(), ARCH_DMA_MINALIGN);
+	job->workspace = memalign(ARCH_DMA_MINALIGN, extra * job->wsize);
+	if (!job->workspace) {
+		ret = -ENOMEM;
+		goto err_frames;
+	}
+
+	ret = smp_call_function_count((ulong)zstd_worker, (ulong)job, 0, 0,
+				      &cpus);
+	if (ret)
+		log_warning("Cannot start all CPUs (err=%d)\n", ret);
+	log_debug("%d frames, %d other CPUs\n", count, cpus);
+
+	zstd_worker(0, (ulong)job, (ulong)ctx);
+	while (__atomic_load_n(&job->done, __ATOMIC_ACQUIRE) < count)
+		;
+	ret = job->err ? job->err : opos;
+	free(job->workspace);
+	free(job->frames);
+
+	/*
+	 * A CPU which has not started yet cannot find any work to do, but
+	 * still reads @job, so it must not be freed until they have all
+	 * returned
+	 */
+	start = get_timer(0);
+	while (__atomic_load_n(&job->returned, __ATOMIC_ACQUIRE) < cpus + 1) {
+		if (get_timer(start) > ZSTD_PARALLEL_TIMEOUT_MS) {
+			log_warning("Other CPUs did not return\n");
+			return ret;
+		}
+	}
+	free(job);
+
+	return ret;
+
+err_frames:
+	free(job->frames);
+err_job:
+	free(job);
+	return ret;
+}
+#endif
 
 int zstd_decompress(struct abuf *in, struct abuf *out)
 {
 	zstd_dctx *ctx;
 	size_t wsize, len;
 	void *workspace;
-	int ret;
+	int count, ret;
 
 	wsize = zstd_dctx_workspace_bound();
 	workspace = malloc(wsize);
@@ -34,10 +283,10 @@ int zstd_decompress(struct abuf *in, struct abuf *out)
 	}
 
 	/*
-	 * Find out how large the frame actually is, there may be junk at
-	 * the end of the frame that zstd_decompress_dctx() can't handle.
+	 * Find out how large the frames actually are, there may be junk at
+	 * the end of the last frame that zstd_decompress_dctx() can't handle.
 	 */
-	len = zstd_find_frame_compressed_size(abuf_data(in), abuf_size(in));
+	len = zstd_frames_size(in, &count);
 	if (zstd_is_error(len)) {
 		log_err("%s: failed to detect compressed size: %d\n", __func__,
 			zstd_get_error_code(len));
@@ -45,6 +294,15 @@ int zstd_decompress(struct abuf *in, struct abuf *out)
 		goto do_free;
 	}
 
+#if CONFIG_IS_ENABLED(ZSTD_PARALLEL)
+	if (count > 1) {
+		/* Without memory for the job, use the single workspace */
+		ret = zstd_decompress_parallel(ctx, in, out, count);
+		if (ret != -ENOENT && ret != -ENOMEM)
+			goto do_free;
+	}
+#endif
+
 	len = zstd_decompress_dctx(ctx, abuf_data(out), abuf_size(out),
 				   abuf_data(in), len);
 	if (zstd_is_error(len)) {
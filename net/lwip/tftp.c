@@ -63,6 +63,8 @@ static int store_block(struct tftp_ctx *ctx, void *src, u16_t len)
 	ptr = map_sysmem(store_addr, len);
 	memcpy(ptr, src, len);
 	unmap_sysmem(ptr);
+	if (CONFIG_IS_ENABLED(NET_LOAD_HASH))
+		hash_stream_update(net_load_hash, ctx->size, src, len);
 
 	ctx->daddr += len;
 	ctx->size += len;
@@ -99,6 +101,7 @@ static void tftp_close(void *handle)
 	}
 	puts("\ndone\n");
 	printf("Bytes transferred = %lu (%lx hex)\n", ctx->size, ctx->size);
+	net_load_hash_finish(ctx->size);
 
 	if (env_set_hex("filesize", ctx->size)) {
 		log_err("filesize not updated\n");
@@ -177,6 +180,7 @@ static int tftp_loop(struct udevice *udev, ulong addr, char *fname,
 	ctx.size = 0;
 	ctx.block_count = 0;
 	ctx.daddr = addr;
+	net_load_hash_start();
 
 	printf("Using %s device\n", udev->name);
 	printf("TFTP from server %s; our IP address is %s\n",
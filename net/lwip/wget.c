@@ -6,6 +6,7 @@
 #include <display_options.h>
 #include <efi_loader.h>
 #include <env.h>
+#include <hash.h>
 #include <linux/kconfig.h>
 #include <lwip/apps/http_client.h>
 #include "lwip/altcp_tls.h"
@@ -171,6 +172,8 @@ static int store_block(struct wget_ctx *ctx, void *src, u16_t len)
 	ptr = map_sysmem(store_addr, len);
 	memcpy(ptr, src, len);
 	unmap_sysmem(ptr);
+	if (CONFIG_IS_ENABLED(NET_LOAD_HASH))
+		hash_stream_update(net_load_hash, ctx->size, src, len);
 
 	ctx->daddr += len;
 	ctx->size += len;
@@ -250,6 +253,7 @@ static void httpc_result_cb(void *arg, httpc_result_t httpc_result,
 		efi_set_bootdev("Http", ctx->server_name, ctx->path, map_sysmem(ctx->saved_daddr, 0),
 				rx_content_len);
 	wget_lwip_set_file_size(rx_content_len);
+	net_load_hash_finish(ctx->size);
 	if (env_set_hex("filesize", rx_content_len) ||
 	    env_set_hex("fileaddr", ctx->saved_daddr)) {
 		log_err("Could not set filesize or fileaddr\n");
@@ -294,6 +298,7 @@ int wget_do_request(ulong dst_addr, char *uri)
 	ctx.size = 0;
 	ctx.prevsize = 0;
 	ctx.start_time = 0;
+	net_load_hash_start();
 
 	if (parse_url(uri, ctx.server_name, &ctx.port, &path, &is_https))
 		return CMD_RET_USAGE;
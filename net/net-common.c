@@ -2,6 +2,8 @@
 
 #include <dm/uclass.h>
 #include <env.h>
+#include <hash.h>
+#include <hexdump.h>
 #include <net-common.h>
 #include <linux/time.h>
 #include <rtc.h>
@@ -43,6 +45,47 @@ int wget_request(ulong dst_addr, char *uri, struct wget_http_info *info)
 	return wget_do_request(dst_addr, uri);
 }
 
+#if CONFIG_IS_ENABLED(NET_LOAD_HASH)
+static struct hash_stream net_load_hash_stream;
+struct hash_stream *net_load_hash;
+
+void net_load_hash_start(void)
+{
+	const char *algo = env_get("loadhash");
+
+	hash_stream_abort(net_load_hash);
+	net_load_hash = NULL;
+	env_set("filehash", NULL);
+	if (!algo)
+		return;
+	if (hash_stream_start(&net_load_hash_stream, algo)) {
+		printf("Cannot hash with '%s'\n", algo);
+		return;
+	}
+	net_load_hash = &net_load_hash_stream;
+}
+
+void net_load_hash_finish(ulong size)
+{
+	struct hash_stream *hs = net_load_hash;
+	char str[HASH_MAX_DIGEST_SIZE * 2 + 1];
+
+	if (!hs)
+		return;
+	net_load_hash = NULL;
+	if (!size || hs->size != size) {
+		hash_stream_abort(hs);
+		if (size)
+			printf("Could not hash downloaded file\n");
+		return;
+	}
+	if (hash_stream_finish(hs))
+		return;
+	*bin2hex(str, hs->digest, hs->digest_size) = '\0';
+	env_set("filehash", str);
+}
+#endif
+
 void net_sntp_set_rtc(u32 seconds)
 {
 	struct rtc_time tm;
@@ -179,6 +179,8 @@ static inline int store_block(int block, uchar *src, unsigned int len)
 	ptr = map_sysmem(store_addr, len);
 	memcpy(ptr, src, len);
 	unmap_sysmem(ptr);
+	if (CONFIG_IS_ENABLED(NET_LOAD_HASH))
+		hash_stream_update(net_load_hash, offset, src, len);
 
 	if (net_boot_file_size < newsize)
 		net_boot_file_size = newsize;
@@ -308,10 +310,12 @@ static void tftp_complete(void)
 
 	led_activity_off();
 
-	if (!tftp_put_active)
+	if (!tftp_put_active) {
 		efi_set_bootdev("Net", "", tftp_filename,
 				map_sysmem(tftp_load_addr, 0),
 				net_boot_file_size);
+		net_load_hash_finish(net_boot_file_size);
+	}
 	net_set_state(NETLOOP_SUCCESS);
 }
 
@@ -771,6 +775,9 @@ void tftp_start(enum proto_t protocol)
 {
 	__maybe_unused char *ep;             /* Environment pointer */
 
+	if (protocol == TFTPGET)
+		net_load_hash_start();
+
 	if (saved_tftp_block_size_option) {
 		tftp_block_size_option = saved_tftp_block_size_option;
 		saved_tftp_block_size_option = 0;
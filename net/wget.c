@@ -70,6 +70,9 @@ static inline int store_block(uchar *src, unsigned int offset, unsigned int len)
 	ptr = map_sysmem(store_addr, len);
 	memcpy(ptr, src, len);
 	unmap_sysmem(ptr);
+	/* Until the header is parsed, @offset includes the header */
+	if (CONFIG_IS_ENABLED(NET_LOAD_HASH) && http_hdr_size)
+		hash_stream_update(net_load_hash, offset, src, len);
 
 	return 0;
 }
@@ -116,6 +119,8 @@ static void tcp_stream_on_closed(struct tcp_stream *tcp)
 		printf("\nPackets received %d, Transfer Successful\n",
 		       tcp->rx_packets);
 	wget_info->file_size = net_boot_file_size;
+	if (wget_info->method == WGET_HTTP_METHOD_GET)
+		net_load_hash_finish(net_boot_file_size);
 	if (wget_info->method == WGET_HTTP_METHOD_GET && wget_info->set_bootdev) {
 		efi_set_bootdev("Http", NULL, image_url,
 				map_sysmem(image_load_addr, 0),
@@ -228,6 +233,12 @@ static void tcp_stream_on_rcv_nxt_update(struct tcp_stream *tcp, u32 rx_bytes)
 
 	net_boot_file_size = rx_bytes - http_hdr_size;
 	memmove(ptr, ptr + http_hdr_size, max_rx_pos + 1 - http_hdr_size);
+	/*
+	 * The segments received so far were stored before the header size
+	 * was known, so hash the body which is now in place
+	 */
+	if (CONFIG_IS_ENABLED(NET_LOAD_HASH))
+		hash_stream_update(net_load_hash, 0, ptr, net_boot_file_size);
 	wget_loop_state = NETLOOP_SUCCESS;
 
 end:
@@ -342,6 +353,8 @@ void wget_start(void)
 
 	max_rx_pos = (u32)(-1);
 	net_boot_file_size = 0;
+	if (wget_info->method == WGET_HTTP_METHOD_GET)
+		net_load_hash_start();
 	http_hdr_size = 0;
 	wget_tsize_num_hash = 0;
 	wget_loop_state = NETLOOP_FAIL;
@@ -242,6 +242,41 @@ static int net_test_wget(struct unit_test_state *uts)
 }
 CMD_TEST(net_test_wget, UTF_CONSOLE);
 
+/* Check that the file is hashed while it downloads, without its header */
+static int net_test_wget_loadhash(struct unit_test_state *uts)
+{
+	char *prev_ethact = env_get("ethact");
+	char *prev_ethrotate = env_get("ethrotate");
+
+	if (!CONFIG_IS_ENABLED(NET_LOAD_HASH))
+		return -EAGAIN;
+
+	sandbox_eth_set_tx_handler(0, sb_http_handler);
+	sandbox_eth_set_priv(0, uts);
+
+	env_set("ethact", "eth@10002000");
+	env_set("ethrotate", "no");
+	env_set("wgetaddr", "0x20000");
+	env_set("loadhash", "sha256");
+	ut_assertok(run_command("wget ${wgetaddr} 1.1.2.2:/index.html", 0));
+	ut_assert_nextline_empty();
+	ut_assert_nextline("Packets received 5, Transfer Successful");
+	ut_assert_nextline("Bytes transferred = 29 (1d hex)");
+	ut_assert_console_end();
+
+	sandbox_eth_set_tx_handler(0, NULL);
+
+	ut_asserteq_str("a4909d8afa180741173959188dc9718e076011fb026f8df0855658a27ee7f606",
+			env_get("filehash"));
+
+	env_set("loadhash", NULL);
+	env_set("ethact", prev_ethact);
+	env_set("ethrotate", prev_ethrotate);
+
+	return 0;
+}
+CMD_TEST(net_test_wget_loadhash, UTF_CONSOLE);
+
 static int net_test_wget_uri_validate(struct unit_test_state *uts)
 {
 	ut_asserteq(true, wget_validate_uri("http://foo.com/bar.html"));
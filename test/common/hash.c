@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for hashing data while it is loaded
+ */
+
+#include <hash.h>
+#include <malloc.h>
+#include <test/common.h>
+#include <test/test.h>
+#include <test/ut.h>
+#include <u-boot/sha256.h>
+
+#define HASH_TEST_SIZE	5000
+
+static u8 *hash_test_data(void)
+{
+	u8 *buf;
+	int i;
+
+	buf = malloc(HASH_TEST_SIZE);
+	if (buf) {
+		for (i = 0; i < HASH_TEST_SIZE; i++)
+			buf[i] = i * 13 + (i >> 8);
+	}
+
+	return buf;
+}
+
+/* Test hashing data which arrives in pieces */
+static int common_test_hash_stream(struct unit_test_state *uts)
+{
+	u8 expect[SHA256_SUM_LEN];
+	struct hash_stream hs;
+	u8 *buf;
+
+	buf = hash_test_data();
+	ut_assertnonnull(buf);
+	sha256_csum_wd(buf, HASH_TEST_SIZE, expect, CHUNKSZ_SHA256);
+
+	ut_asserteq(-EPROTONOSUPPORT, hash_stream_start(&hs, "nothing"));
+	ut_asserteq(-ENOENT, hash_stream_finish(&hs));
+
+	/* Pieces which repeat or overlap earlier ones are fine */
+	ut_assertok(hash_stream_start(&hs, "sha256"));
+	ut_assertok(hash_stream_update(&hs, 0, buf, 1000));
+	ut_assertok(hash_stream_update(&hs, 0, buf, 1000));
+	ut_assertok(hash_stream_update(&hs, 500, buf + 500, 1500));
+	ut_assertok(hash_stream_update(&hs, 2000, buf + 2000,
+				       HASH_TEST_SIZE - 2000));
+	ut_asserteq(HASH_TEST_SIZE, hs.size);
+	ut_assertok(hash_stream_finish(&hs));
+	ut_assert(hs.done);
+	ut_asserteq(SHA256_SUM_LEN, hs.digest_size);
+	ut_asserteq_mem(expect, hs.digest, SHA256_SUM_LEN);
+
+	/* Further updates are ignored */
+	ut_assertok(hash_stream_update(&hs, HASH_TEST_SIZE, buf, 10));
+	ut_asserteq(HASH_TEST_SIZE, hs.size);
+
+	/* A gap stops the stream */
+	ut_assertok(hash_stream_start(&hs, "sha256"));
+	ut_assertok(hash_stream_update(&hs, 0, buf, 1000));
+	ut_asserteq(-EIO, hash_stream_update(&hs, 1001, buf + 1001, 1000));
+	ut_assert(hs.failed);
+	ut_asserteq(-EIO, hash_stream_update(&hs, 1000, buf + 1000, 1000));
+	ut_asserteq(-EIO, hash_stream_finish(&hs));
+	ut_assert(!hs.done);
+
+	/* An aborted stream gives no digest */
+	ut_assertok(hash_stream_start(&hs, "sha256"));
+	ut_assertok(hash_stream_update(&hs, 0, buf, HASH_TEST_SIZE));
+	hash_stream_abort(&hs);
+	ut_asserteq(-EIO, hash_stream_finish(&hs));
+
+	/* A NULL stream is ignored */
+	ut_assertok(hash_stream_update(NULL, 0, buf, HASH_TEST_SIZE));
+	hash_stream_abort(NULL);
+
+	free(buf);
+
+	return 0;
+}
+COMMON_TEST(common_test_hash_stream, 0);
@@ -8,10 +8,14 @@
 #include <errno.h>
 #include <dm.h>
 #include <fdtdec.h>
+#include <i2c.h>
 #include <log.h>
 #include <malloc.h>
+#include <time.h>
 #include <asm/global_data.h>
 #include <dm/device-internal.h>
+#include <dm/devres.h>
+#include <dm/lists.h>
 #include <dm/root.h>
 #include <dm/util.h>
 #include <dm/test.h>
@@ -19,6 +23,7 @@
 #include <linux/list.h>
 #include <test/test.h>
 #include <test/ut.h>
+#include <uthread.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -1389,6 +1394,52 @@ static int dm_test_dev_get_mem(struct unit_test_state *uts)
 }
 DM_TEST(dm_test_dev_get_mem, UTF_SCAN_FDT);
 
+#if CONFIG_IS_ENABLED(DM_POOL)
+/* Test that devices and their data are allocated from the pools */
+static int dm_test_dev_pool(struct unit_test_state *uts)
+{
+	struct dm_pool_stats before[DM_POOL_COUNT], after[DM_POOL_COUNT];
+	struct udevice *dev;
+	ulong mem_start;
+	int i, used;
+	void *ptr;
+
+	dm_pool_get_stats(before);
+	for (i = 1; i < DM_POOL_COUNT; i++)
+		ut_assert(before[i].size > before[i - 1].size);
+
+	mem_start = ut_check_delta(0);
+	ut_assertok(device_bind_by_name(uts->root, false, &driver_info_manual,
+					&dev));
+	ut_assert(ut_check_delta(mem_start) > 0);
+	dm_pool_get_stats(after);
+	for (i = 0, used = 0; i < DM_POOL_COUNT; i++)
+		used += after[i].used - before[i].used;
+	ut_assert(used > 0);
+
+	/* Everything goes back to the pools, and empty slabs to the heap */
+	ut_assertok(device_unbind(dev));
+	dm_pool_get_stats(after);
+	for (i = 0; i < DM_POOL_COUNT; i++) {
+		ut_asserteq(before[i].used, after[i].used);
+		ut_asserteq(before[i].slab_count, after[i].slab_count);
+	}
+	ut_asserteq(0, ut_check_delta(mem_start));
+
+	/* Anything larger than the largest pool uses malloc() */
+	ptr = dm_pool_alloc(before[DM_POOL_COUNT - 1].size + 1);
+	ut_assertnonnull(ptr);
+	dm_pool_get_stats(after);
+	ut_asserteq(before[DM_POOL_COUNT - 1].used,
+		    after[DM_POOL_COUNT - 1].used);
+	dm_pool_free(ptr);
+	ut_asserteq(0, ut_check_delta(mem_start));
+
+	return 0;
+}
+DM_TEST(dm_test_dev_pool, 0);
+#endif
+
 /* Test uclass_try_first_device() */
 static int dm_test_try_first_device(struct unit_test_state *uts)
 {
@@ -1410,3 +1461,454 @@ static int dm_test_try_first_device(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_try_first_device, 0);
+
+/* Check that the compatible index finds the same driver as a full search */
+static int dm_test_compat_index(struct unit_test_state *uts)
+{
+	struct driver *driver = ll_entry_start(struct driver, driver);
+	const int n_ents = ll_entry_count(struct driver, driver);
+	struct lists_compat_entry *idx;
+	struct udevice *dev;
+	int count, i;
+
+	if (!CONFIG_IS_ENABLED(DM_COMPAT_INDEX))
+		return -EAGAIN;
+
+	idx = gd_dm_compat_index();
+	count = gd_dm_compat_count();
+	ut_assertnonnull(idx);
+	ut_assert(count > 0);
+
+	for (i = 0; i < count; i++) {
+		const char *compat = idx[i].id->compatible;
+		const struct udevice_id *id;
+		struct driver *entry;
+
+		if (i && !strcmp(idx[i - 1].id->compatible, compat))
+			continue;
+		if (i)
+			ut_assert(strcmp(idx[i - 1].id->compatible, compat) < 0);
+
+		/* The first entry for each string must be the first driver */
+		for (entry = driver; entry != driver + n_ents; entry++) {
+			for (id = entry->of_match; id && id->compatible; id++) {
+				if (!strcmp(id->compatible, compat))
+					break;
+			}
+			if (id && id->compatible)
+				break;
+		}
+		ut_asserteq_ptr(entry, idx[i].drv);
+		ut_asserteq_ptr(id, idx[i].id);
+	}
+
+	/* Devices bound from the devicetree still get the right driver */
+	ut_assertok(uclass_get_device_by_name(UCLASS_TEST_FDT, "a-test", &dev));
+	ut_asserteq_str("testfdt_drv", dev->driver->name);
+	ut_asserteq(DM_TEST_TYPE_FIRST, dev_get_driver_data(dev));
+
+	return 0;
+}
+DM_TEST(dm_test_compat_index, UTF_SCAN_FDT);
+
+/* Walk the uclass list as uclass_find() does without the uclass table */
+static struct uclass *uclass_find_by_walk(enum uclass_id id)
+{
+	struct uclass *uc;
+
+	list_for_each_entry(uc, gd->uclass_root, sibling_node) {
+		if (uc->uc_drv->id == id)
+			return uc;
+	}
+
+	return NULL;
+}
+
+/* Test that the uclass table tracks the uclass list */
+static int dm_test_uclass_table(struct unit_test_state *uts)
+{
+	struct uclass **table;
+	struct uclass *uc;
+	ulong start, walk_us, table_us;
+	int i, count;
+
+	if (!CONFIG_IS_ENABLED(DM_UCLASS_TABLE))
+		return -EAGAIN;
+
+	table = gd_uclass_table();
+	ut_assertnonnull(table);
+
+	count = 0;
+	list_for_each_entry(uc, gd->uclass_root, sibling_node) {
+		ut_asserteq_ptr(uc, table[uc->uc_drv->id]);
+		count++;
+	}
+	for (i = 0; i < UCLASS_COUNT; i++) {
+		if (table[i])
+			count--;
+	}
+	ut_asserteq(0, count);
+	ut_assertnull(uclass_find(UCLASS_INVALID));
+	ut_assertnull(uclass_find(UCLASS_COUNT));
+
+	/* Removing a uclass must clear its entry, adding it must set it */
+	ut_assertok(uclass_get(UCLASS_TEST, &uc));
+	ut_asserteq_ptr(uc, table[UCLASS_TEST]);
+	ut_assertok(uclass_destroy(uc));
+	ut_assertnull(table[UCLASS_TEST]);
+	ut_assertnull(uclass_find(UCLASS_TEST));
+	ut_assertok(uclass_get(UCLASS_TEST, &uc));
+	ut_asserteq_ptr(uc, uclass_find(UCLASS_TEST));
+
+	/* Look up the oldest uclass, which is at the end of the list */
+	uc = list_last_entry(gd->uclass_root, struct uclass, sibling_node);
+	start = timer_get_us();
+	for (i = 0; i < 10000; i++)
+		ut_asserteq_ptr(uc, uclass_find_by_walk(uc->uc_drv->id));
+	walk_us = timer_get_us() - start;
+
+	start = timer_get_us();
+	for (i = 0; i < 10000; i++)
+		ut_asserteq_ptr(uc, uclass_find(uc->uc_drv->id));
+	table_us = timer_get_us() - start;
+	printf("uclass lookup x10000: walk %lu us, table %lu us\n", walk_us,
+	       table_us);
+
+	return 0;
+}
+DM_TEST(dm_test_uclass_table, UTF_SCAN_PDATA | UTF_SCAN_FDT);
+
+#if CONFIG_IS_ENABLED(DM_PROBE_THREADS)
+enum {
+	PROBE_THREAD_NONE,
+	PROBE_THREAD_PARENT,
+	PROBE_THREAD_CHILD,
+	PROBE_THREAD_CYCLE,
+	PROBE_THREAD_BUS,
+	PROBE_THREAD_FAIL,
+};
+
+static int probe_thread_parent_count;
+static bool probe_thread_parent_done;
+static int probe_thread_child_ok;
+static struct udevice *probe_thread_cycle[2];
+static int probe_thread_on_bus;
+static int probe_thread_bus_clash;
+
+static int dm_test_probe_thread_probe(struct udevice *dev)
+{
+	struct udevice *peer;
+
+	switch (dev_get_driver_data(dev)) {
+	case PROBE_THREAD_NONE:
+		break;
+	case PROBE_THREAD_PARENT:
+		/* Give the other threads a chance to run in the middle */
+		probe_thread_parent_count++;
+		uthread_schedule();
+		uthread_schedule();
+		probe_thread_parent_done = true;
+		break;
+	case PROBE_THREAD_CHILD:
+		if (probe_thread_parent_done)
+			probe_thread_child_ok++;
+		break;
+	case PROBE_THREAD_CYCLE:
+		/* Each of the two devices needs the other */
+		uthread_schedule();
+		peer = probe_thread_cycle[dev == probe_thread_cycle[0]];
+		return device_probe(peer);
+	case PROBE_THREAD_BUS:
+		/* No other device on the bus may probe while this one waits */
+		if (probe_thread_on_bus++)
+			probe_thread_bus_clash++;
+		uthread_schedule();
+		probe_thread_on_bus--;
+		break;
+	case PROBE_THREAD_FAIL:
+		return -EIO;
+	}
+
+	return 0;
+}
+
+U_BOOT_DRIVER(dm_test_probe_thread) = {
+	.name	= "dm_test_probe_thread",
+	.id	= UCLASS_TEST_DUMMY,
+	.probe	= dm_test_probe_thread_probe,
+	.flags	= DM_FLAG_PROBE_THREAD,
+};
+
+static int probe_thread_bind(struct unit_test_state *uts,
+			     struct udevice *parent, const char *name,
+			     ulong data, bool probe, struct udevice **devp)
+{
+	ut_assertok(device_bind_with_driver_data(parent,
+				DM_DRIVER_GET(dm_test_probe_thread), name,
+				data, ofnode_null(), devp));
+	if (probe)
+		dev_or_flags(*devp, DM_FLAG_PROBE_AFTER_BIND);
+
+	return 0;
+}
+
+/* Test that threads probing devices with a shared parent wait for each other */
+static int dm_test_probe_threads(struct unit_test_state *uts)
+{
+	struct udevice *parent, *bus1, *bus2, *child1, *child2;
+
+	probe_thread_parent_count = 0;
+	probe_thread_parent_done = false;
+	probe_thread_child_ok = 0;
+
+	/* Each bus gets its own thread, and both need the parent */
+	ut_assertok(probe_thread_bind(uts, uts->root, "parent",
+				      PROBE_THREAD_PARENT, false, &parent));
+	ut_assertok(probe_thread_bind(uts, parent, "bus1", PROBE_THREAD_NONE,
+				      false, &bus1));
+	ut_assertok(probe_thread_bind(uts, parent, "bus2", PROBE_THREAD_NONE,
+				      false, &bus2));
+	ut_assertok(probe_thread_bind(uts, bus1, "child1",
+				      PROBE_THREAD_CHILD, true, &child1));
+	ut_assertok(probe_thread_bind(uts, bus2, "child2",
+				      PROBE_THREAD_CHILD, true, &child2));
+
+	ut_assertok(dm_autoprobe());
+	ut_assert(device_active(parent));
+	ut_assert(device_active(child1));
+	ut_assert(device_active(child2));
+
+	/* The parent was probed once, and both children saw it complete */
+	ut_asserteq(1, probe_thread_parent_count);
+	ut_asserteq(2, probe_thread_child_ok);
+
+	return 0;
+}
+DM_TEST(dm_test_probe_threads, 0);
+
+/* Test that two devices needing each other do not leave threads waiting */
+static int dm_test_probe_threads_cycle(struct unit_test_state *uts)
+{
+	struct udevice *bus1, *bus2;
+
+	ut_assertok(probe_thread_bind(uts, uts->root, "bus1", PROBE_THREAD_NONE,
+				      false, &bus1));
+	ut_assertok(probe_thread_bind(uts, uts->root, "bus2", PROBE_THREAD_NONE,
+				      false, &bus2));
+	ut_assertok(probe_thread_bind(uts, bus1, "cycle0", PROBE_THREAD_CYCLE,
+				      true, &probe_thread_cycle[0]));
+	ut_assertok(probe_thread_bind(uts, bus2, "cycle1", PROBE_THREAD_CYCLE,
+				      true, &probe_thread_cycle[1]));
+
+	ut_assertok(dm_autoprobe());
+	ut_assert(device_active(probe_thread_cycle[0]));
+	ut_assert(device_active(probe_thread_cycle[1]));
+
+	return 0;
+}
+DM_TEST(dm_test_probe_threads_cycle, 0);
+
+/* Test that devices on one bus are probed one at a time */
+static int dm_test_probe_threads_bus(struct unit_test_state *uts)
+{
+	struct udevice *bus, *dev;
+
+	probe_thread_on_bus = 0;
+	probe_thread_bus_clash = 0;
+
+	ut_assertok(probe_thread_bind(uts, uts->root, "bus", PROBE_THREAD_NONE,
+				      false, &bus));
+	ut_assertok(probe_thread_bind(uts, bus, "dev0", PROBE_THREAD_BUS, true,
+				      &dev));
+	ut_assertok(probe_thread_bind(uts, bus, "dev1", PROBE_THREAD_BUS, true,
+				      &dev));
+	ut_assertok(probe_thread_bind(uts, bus, "dev2", PROBE_THREAD_BUS, true,
+				      &dev));
+
+	ut_assertok(dm_autoprobe());
+	ut_assert(device_active(dev));
+	ut_asserteq(0, probe_thread_bus_clash);
+
+	return 0;
+}
+DM_TEST(dm_test_probe_threads_bus, 0);
+
+/* Test that a probe failure in a thread is returned by dm_autoprobe() */
+static int dm_test_probe_threads_fail(struct unit_test_state *uts)
+{
+	struct udevice *dev, *bad;
+
+	ut_assertok(probe_thread_bind(uts, uts->root, "good", PROBE_THREAD_NONE,
+				      true, &dev));
+	ut_assertok(probe_thread_bind(uts, uts->root, "bad", PROBE_THREAD_FAIL,
+				      true, &bad));
+
+	ut_asserteq(-EIO, dm_autoprobe());
+	ut_assert(device_active(dev));
+	ut_assert(!device_active(bad));
+
+	return 0;
+}
+DM_TEST(dm_test_probe_threads_fail, 0);
+#endif
+
+#if CONFIG_IS_ENABLED(DM_TIMING)
+/* Test recording the time and memory used by devices and drivers */
+static int dm_test_dev_timing(struct unit_test_state *uts)
+{
+	struct dm_driver_timing *list;
+	struct devres_stats stats;
+	int count, dev_count, i;
+	struct udevice *dev;
+	ulong time_us, mem;
+
+	ut_assertok(uclass_first_device_err(UCLASS_TEST_FDT, &dev));
+	ut_asserteq_str("a-test", dev->name);
+	ut_asserteq(dev->timing.bind_us + dev->timing.of_to_plat_us +
+		    dev->timing.pre_probe_us + dev->timing.probe_us +
+		    dev->timing.post_probe_us, dev_get_time_us(dev));
+
+	memset(&stats, '\0', sizeof(stats));
+	devres_get_stats(dev, &stats);
+	ut_asserteq(sizeof(struct udevice) + sizeof(struct dm_test_pdata) +
+		    sizeof(struct dm_test_priv) + stats.total_size,
+		    dev_get_mem(dev));
+
+	/* Each device must be counted once, against its own driver */
+	count = dm_get_driver_timing(&list);
+	ut_assert(count > 0);
+	dev_count = 0;
+	time_us = -1UL;
+	mem = 0;
+	for (i = 0; i < count; i++) {
+		ut_assert(list[i].time_us <= time_us);
+		time_us = list[i].time_us;
+		dev_count += list[i].dev_count;
+		if (list[i].drv == dev->driver)
+			mem = list[i].mem;
+	}
+	free(list);
+	ut_asserteq(device_get_decendent_count(dm_root()), dev_count);
+	ut_assert(mem >= dev_get_mem(dev));
+
+	return 0;
+}
+DM_TEST(dm_test_dev_timing, UTF_SCAN_FDT);
+#endif
+
+#if CONFIG_IS_ENABLED(DM_LAZY_BIND)
+/* Test that recorded nodes are bound when they are looked up */
+static int dm_test_lazy_bind(struct unit_test_state *uts)
+{
+	struct udevice *dev;
+	struct uclass *uc;
+	int eager;
+
+	ut_assertok(dm_lazy_init());
+	ut_assertok(dm_scan_fdt(false));
+
+	/* a-test has bootph-all so is bound now, but the others are not */
+	uc = uclass_find(UCLASS_TEST_FDT);
+	ut_assertnonnull(uc);
+	eager = list_count_nodes(&uc->dev_head);
+	ut_assert(eager > 0);
+	ut_assertok(uclass_get(UCLASS_TEST_FDT, &uc));
+	ut_assert(list_count_nodes(&uc->dev_head) > eager);
+
+	/* Looking up a node binds just that node */
+	ut_assertnull(uclass_find(UCLASS_PWM));
+	ut_assertok(device_find_global_by_ofnode(ofnode_path("/pwm2"), &dev));
+	ut_asserteq_str("pwm2", dev->name);
+	uc = uclass_find(UCLASS_PWM);
+	ut_assertnonnull(uc);
+	ut_asserteq(1, list_count_nodes(&uc->dev_head));
+
+	ut_assert(dm_lazy_bind_all() > 0);
+	ut_asserteq(0, dm_lazy_bind_all());
+	ut_assert(list_count_nodes(&uc->dev_head) > 1);
+
+	dm_lazy_uninit();
+
+	return 0;
+}
+DM_TEST(dm_test_lazy_bind, 0);
+
+/* Test that looking through the children of a bus binds recorded children */
+static int dm_test_lazy_bind_children(struct unit_test_state *uts)
+{
+	struct udevice *bus, *dev, *found = NULL;
+	ofnode pmic_node;
+	int count;
+
+	ut_assertok(dm_lazy_init());
+	ut_assertok(dm_scan_fdt(false));
+
+	/* Binding the bus records its children, rather than binding them */
+	ut_assertok(device_find_global_by_ofnode(ofnode_path("/i2c@0"), &bus));
+	pmic_node = ofnode_path("/i2c@0/sandbox_pmic@40");
+	device_foreach_child(dev, bus)
+		ut_assert(!ofnode_equal(pmic_node, dev_ofnode(dev)));
+
+	/* Search the bus as i2c_get_chip() does */
+	for (device_find_first_child(bus, &dev); dev;
+	     device_find_next_child(&dev)) {
+		struct dm_i2c_chip *chip = dev_get_parent_plat(dev);
+
+		if (chip->chip_addr == 0x40)
+			found = dev;
+	}
+	ut_assertnonnull(found);
+	ut_assert(ofnode_equal(pmic_node, dev_ofnode(found)));
+
+	/* Nothing is bound twice */
+	count = device_get_child_count(bus);
+	ut_assert(count > 1);
+	ut_asserteq(count, device_get_child_count(bus));
+
+	dm_lazy_uninit();
+
+	return 0;
+}
+DM_TEST(dm_test_lazy_bind_children, 0);
+
+/* Test following a phandle to a device which its parent binds in bind() */
+static int dm_test_lazy_bind_phandle(struct unit_test_state *uts)
+{
+	ofnode options, pmic_node;
+	struct udevice *dev;
+	struct uclass *uc;
+	u32 phandle;
+
+	/* Restart driver model with lazy binding enabled by the devicetree */
+	options = ofnode_path("/options/u-boot");
+	ut_assertok(ofnode_write_bool(options, "dm-lazy-bind", true));
+	ut_assertok(dm_uninit());
+	ut_assertok(dm_init(uts->of_live));
+	uts->root = dm_root();
+	ut_assertok(ofnode_write_bool(options, "dm-lazy-bind", false));
+	ut_assertnonnull(gd_dm_lazy());
+	ut_assertok(dm_extended_scan(false));
+
+	/* The PMIC, which binds the regulators, is not bound yet */
+	pmic_node = ofnode_path("/i2c@0/sandbox_pmic@40");
+	ut_assert(ofnode_valid(pmic_node));
+	uc = uclass_find(UCLASS_PMIC);
+	if (uc) {
+		uclass_foreach_dev(dev, uc)
+			ut_assert(!ofnode_equal(pmic_node, dev_ofnode(dev)));
+	}
+
+	/* Looking up the supply binds the I2C bus and PMIC on the way */
+	ut_assertok(ofnode_read_u32(ofnode_path("/adc@0"), "vdd-supply",
+				    &phandle));
+	ut_assertok(uclass_get_device_by_phandle_id(UCLASS_REGULATOR, phandle,
+						    &dev));
+	ut_asserteq_str("buck2", dev->name);
+	ut_assert(ofnode_equal(pmic_node, dev_ofnode(dev->parent)));
+
+	dm_lazy_uninit();
+
+	return 0;
+}
+DM_TEST(dm_test_lazy_bind_phandle, 0);
+#endif
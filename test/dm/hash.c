@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for the hash uclass and the choice between engines and the CPU
+ */
+
+#include <dm.h>
+#include <hash.h>
+#include <malloc.h>
+#include <asm/test.h>
+#include <dm/test.h>
+#include <test/ut.h>
+#include <u-boot/hash.h>
+#include <u-boot/sha256.h>
+
+#define HASH_TEST_LARGE	8192
+#define HASH_TEST_SMALL	64
+
+/* Check which inputs hash_find_device() gives to the engine */
+static int dm_test_hash_find(struct unit_test_state *uts)
+{
+	struct udevice *dev, *engine;
+	struct hash_uc_plat *plat;
+
+	ut_assertok(uclass_get_device_by_driver(UCLASS_HASH,
+						 DM_DRIVER_GET(sandbox_hash),
+						 &engine));
+
+	/* The devicetree sets the crossover at 4KB */
+	ut_asserteq(-ENODEV, hash_find_device(HASH_ALGO_SHA256,
+					      HASH_TEST_SMALL, &dev));
+	ut_assertok(hash_find_device(HASH_ALGO_SHA256, HASH_TEST_LARGE, &dev));
+	ut_asserteq_ptr(engine, dev);
+	ut_assertok(hash_find_device(HASH_ALGO_SHA256, ULONG_MAX, &dev));
+	ut_asserteq_ptr(engine, dev);
+
+	/* The engine does not do MD5 */
+	ut_asserteq(-ENODEV, hash_find_device(HASH_ALGO_MD5, HASH_TEST_LARGE,
+					      &dev));
+	ut_asserteq(-ENODEV, hash_find_device(HASH_ALGO_INVALID,
+					      HASH_TEST_LARGE, &dev));
+
+	/* An engine disabled for an algorithm is not used, whatever the size */
+	plat = dev_get_uclass_plat(engine);
+	plat->disabled |= BIT(HASH_ALGO_SHA256);
+	ut_asserteq(-ENODEV, hash_find_device(HASH_ALGO_SHA256, ULONG_MAX,
+					      &dev));
+	ut_assertok(hash_find_device(HASH_ALGO_SHA1, ULONG_MAX, &dev));
+	ut_asserteq_ptr(engine, dev);
+	plat->disabled &= ~BIT(HASH_ALGO_SHA256);
+
+	return 0;
+}
+DM_TEST(dm_test_hash_find, UTF_SCAN_FDT);
+
+/* Check that hashing through the engine gives the same result */
+static int dm_test_hash_offload(struct unit_test_state *uts)
+{
+	u8 expect[SHA256_SUM_LEN], out[SHA256_SUM_LEN];
+	struct hash_algo *algo;
+	struct udevice *dev;
+	int count, i;
+	void *ctx;
+	u8 *buf;
+
+	ut_assertok(uclass_get_device_by_driver(UCLASS_HASH,
+						 DM_DRIVER_GET(sandbox_hash),
+						 &dev));
+	buf = malloc(HASH_TEST_LARGE);
+	ut_assertnonnull(buf);
+	for (i = 0; i < HASH_TEST_LARGE; i++)
+		buf[i] = i * 7;
+
+	/* A small block stays on the CPU */
+	count = sandbox_hash_get_count(dev);
+	sha256_csum_wd(buf, HASH_TEST_SMALL, expect, CHUNKSZ_SHA256);
+	ut_assertok(hash_block("sha256", buf, HASH_TEST_SMALL, out, NULL));
+	ut_asserteq_mem(expect, out, sizeof(out));
+	ut_asserteq(count, sandbox_hash_get_count(dev));
+
+	/* A large one goes to the engine */
+	sha256_csum_wd(buf, HASH_TEST_LARGE, expect, CHUNKSZ_SHA256);
+	ut_assertok(hash_block("sha256", buf, HASH_TEST_LARGE, out, NULL));
+	ut_asserteq_mem(expect, out, sizeof(out));
+	ut_asserteq(count + 1, sandbox_hash_get_count(dev));
+
+	/* Progressive hashing does not know the size, so uses the engine */
+	memset(out, '\0', sizeof(out));
+	ut_assertok(hash_progressive_lookup_algo("sha256", &algo));
+	ut_assertok(algo->hash_init(algo, &ctx));
+	ut_assertok(algo->hash_update(algo, ctx, buf, 100, 0));
+	ut_assertok(algo->hash_update(algo, ctx, buf + 100,
+				      HASH_TEST_LARGE - 100, 1));
+	ut_assertok(algo->hash_finish(algo, ctx, out, sizeof(out)));
+	ut_asserteq_mem(expect, out, sizeof(out));
+	ut_asserteq(count + 2, sandbox_hash_get_count(dev));
+
+	free(buf);
+
+	return 0;
+}
+DM_TEST(dm_test_hash_offload, UTF_SCAN_FDT);
@@ -3,10 +3,14 @@
  * Copyright (C) 2015 Google, Inc
  */
 
+#include <cyclic.h>
 #include <dm.h>
 #include <mmc.h>
 #include <part.h>
+#include <time.h>
+#include <asm/test.h>
 #include <dm/test.h>
+#include <u-boot/schedule.h>
 #include <test/test.h>
 #include <test/ut.h>
 
@@ -51,3 +55,68 @@ static int dm_test_mmc_blk(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_mmc_blk, UTF_SCAN_PDATA | UTF_SCAN_FDT);
+
+static bool mmc_cyclic_registered(struct cyclic_info *info)
+{
+	struct cyclic_info *cyclic;
+
+	hlist_for_each_entry(cyclic, cyclic_get_list(), list) {
+		if (cyclic == info)
+			return true;
+	}
+
+	return false;
+}
+
+/* Test initialising an eMMC which is still busy after mmc_start_init() */
+static int dm_test_mmc_async_init(struct unit_test_state *uts)
+{
+	struct udevice *dev;
+	struct mmc *mmc;
+	ulong start;
+
+	if (!CONFIG_IS_ENABLED(MMC_ASYNC_INIT))
+		return -EAGAIN;
+
+	ut_assertok(uclass_get_device(UCLASS_MMC, 0, &dev));
+	mmc = mmc_get_mmc_dev(dev);
+
+	/* Re-initialise the card as an eMMC which is slow to power up */
+	sandbox_mmc_set_emmc(dev, 5);
+	mmc->has_init = 0;
+	ut_assertok(mmc_start_init_async(mmc));
+	ut_asserteq(1, mmc->init_async);
+	ut_asserteq(1, mmc->op_cond_pending);
+	ut_assert(!(mmc->ocr & OCR_BUSY));
+	ut_assert(mmc_cyclic_registered(&mmc->init_cyclic));
+
+	/* Stopping the device must stop the polling */
+	ut_assertok(mmc_deinit(mmc));
+	ut_assert(!mmc_cyclic_registered(&mmc->init_cyclic));
+
+	/* mmc_init() picks up the pending initialisation and completes it */
+	ut_assertok(mmc_init(mmc));
+	ut_asserteq(1, mmc->has_init);
+	ut_asserteq(0, mmc->init_async);
+	ut_assert(!IS_SD(mmc));
+
+	/* Now let the cyclic function see the card become ready */
+	sandbox_mmc_set_emmc(dev, 5);
+	mmc->has_init = 0;
+	ut_assertok(mmc_start_init_async(mmc));
+	ut_assert(mmc_cyclic_registered(&mmc->init_cyclic));
+	start = get_timer(0);
+	while (mmc_cyclic_registered(&mmc->init_cyclic) &&
+	       get_timer(start) < 1000)
+		schedule();
+	ut_assert(!mmc_cyclic_registered(&mmc->init_cyclic));
+	ut_assert(mmc->ocr & OCR_BUSY);
+
+	ut_assertok(mmc_init(mmc));
+	ut_asserteq(1, mmc->has_init);
+	ut_asserteq(0, mmc->init_async);
+	ut_asserteq(0, mmc->op_cond_pending);
+
+	return 0;
+}
+DM_TEST(dm_test_mmc_async_init, UTF_SCAN_PDATA | UTF_SCAN_FDT);
@@ -10,6 +10,7 @@
 #include <test/test.h>
 #include <test/ut.h>
 #include <linux/mtd/mtd.h>
+#include <linux/mtd/nand_ecc.h>
 #include <linux/mtd/rawnand.h>
 
 static int run_test_nand(struct unit_test_state *uts, int dev, bool end)
@@ -119,3 +120,120 @@ static int dm_test_nand1_end(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_nand1_end, UTF_SCAN_FDT);
+
+static int dm_test_nand_read_cache(struct unit_test_state *uts)
+{
+	nand_erase_options_t opts = { };
+	struct mtd_info *mtd;
+	size_t length;
+	loff_t off, size;
+	int *gold;
+	char *buf;
+	int i;
+
+	/* Only the ONFI chip advertises sequential cache reads */
+	mtd = get_nand_dev_by_index(0);
+	ut_assertnonnull(mtd);
+	ut_assert(!NAND_HAS_READ_CACHE(mtd_to_nand(mtd)));
+
+	mtd = get_nand_dev_by_index(1);
+	ut_assertnonnull(mtd);
+	ut_assert(NAND_HAS_READ_CACHE(mtd_to_nand(mtd)));
+
+	off = mtd->erasesize * 2;
+	size = mtd->erasesize * 2;
+	buf = malloc(size);
+	ut_assertnonnull(buf);
+	gold = malloc(size);
+	ut_assertnonnull(gold);
+
+	opts.offset = off;
+	opts.length = size;
+	opts.lim = U32_MAX;
+	ut_assertok(nand_erase_opts(mtd, &opts));
+
+	srand(~off);
+	for (i = 0; i < size / sizeof(int); i++)
+		gold[i] = rand();
+	length = size;
+	ut_assertok(nand_write_skip_bad(mtd, off, &length, NULL, U64_MAX,
+					(void *)gold, 0));
+	ut_asserteq(size, length);
+
+	/* Whole pages, read in sequences ending at the eraseblock boundary */
+	ut_assertok(nand_read_skip_bad(mtd, off, &length, NULL, U64_MAX, buf));
+	ut_asserteq(size, length);
+	ut_asserteq_mem(gold, buf, size);
+
+	/* Partial pages at either end, with whole pages in between */
+	memset(buf, '\0', size);
+	length = size - mtd->writesize;
+	ut_assertok(nand_read_skip_bad(mtd, off + mtd->writesize / 2, &length,
+				       NULL, U64_MAX, buf));
+	ut_asserteq(size - mtd->writesize, length);
+	ut_asserteq_mem((char *)gold + mtd->writesize / 2, buf, length);
+
+	free(gold);
+	free(buf);
+
+	return 0;
+}
+DM_TEST(dm_test_nand_read_cache, UTF_SCAN_FDT);
+
+/* Hamming ECC for a 256-byte block, computed one bit at a time */
+static void nand_ecc_ref(const u8 *dat, u8 *ecc)
+{
+	u8 reg1 = 0, reg2 = 0, reg3 = 0;
+	u16 lp = 0;
+	int i, b;
+
+	for (i = 0; i < 256; i++) {
+		for (b = 0; b < 8; b++) {
+			if (!(dat[i] & BIT(b)))
+				continue;
+			reg1 ^= BIT(b & 1) | BIT(2 + ((b >> 1) & 1)) |
+				BIT(4 + (b >> 2));
+			reg3 ^= i;
+			reg2 ^= ~i;
+		}
+	}
+
+	for (b = 0; b < 8; b++)
+		lp |= ((reg3 >> b) & 1) << (2 * b + 1) |
+		      ((reg2 >> b) & 1) << (2 * b);
+
+	ecc[0] = ~(lp >> 8);
+	ecc[1] = ~lp;
+	ecc[2] = (~reg1 << 2) | 0x03;
+}
+
+static int dm_test_nand_ecc_hamming(struct unit_test_state *uts)
+{
+	u8 buf[256 + 1], ecc[3], calc[3];
+	u8 *dat;
+	int i, j;
+
+	srand(256);
+	for (i = 0; i < 64; i++) {
+		/* Random and sparse data, also at an unaligned address */
+		dat = buf + (i & 2 ? 1 : 0);
+		for (j = 0; j < 256; j++)
+			dat[j] = i & 1 ? rand() : 0;
+		dat[rand() % 256] ^= BIT(rand() % 8);
+
+		nand_ecc_ref(dat, calc);
+		ut_assertok(nand_calculate_ecc(NULL, dat, ecc));
+		ut_asserteq_mem(calc, ecc, sizeof(ecc));
+
+		/* A single bit error in the data is corrected */
+		j = rand() % (256 * 8);
+		dat[j / 8] ^= BIT(j % 8);
+		ut_assertok(nand_calculate_ecc(NULL, dat, calc));
+		ut_asserteq(1, nand_correct_data(NULL, dat, ecc, calc));
+		ut_assertok(nand_calculate_ecc(NULL, dat, calc));
+		ut_asserteq_mem(ecc, calc, sizeof(ecc));
+	}
+
+	return 0;
+}
+DM_TEST(dm_test_nand_ecc_hamming, 0);
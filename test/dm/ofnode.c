@@ -137,6 +137,45 @@ static int dm_test_ofnode_get_by_phandle(struct unit_test_state *uts)
 }
 DM_TEST(dm_test_ofnode_get_by_phandle, UTF_SCAN_PDATA | UTF_SCAN_FDT);
 
+/* test the cache used by ofnode_get_by_phandle() */
+static int dm_test_ofnode_phandle_cache(struct unit_test_state *uts)
+{
+	ofnode node, target;
+	uint phandle;
+
+	if (!CONFIG_IS_ENABLED(OFNODE_PHANDLE_CACHE))
+		return -EAGAIN;
+
+	target = ofnode_path("/phandle-node-1");
+	ut_assert(ofnode_valid(target));
+	ut_assertok(ofnode_read_u32(target, "phandle", &phandle));
+
+	/* a lookup fills the cache, and a second one uses it */
+	ofnode_phandle_cache_clear();
+	ut_assert(!ofnode_valid(ofnode_phandle_cache_find(phandle)));
+	node = ofnode_get_by_phandle(phandle);
+	ut_assert(ofnode_equal(target, node));
+	ut_assert(ofnode_equal(target, ofnode_phandle_cache_find(phandle)));
+	ut_assert(ofnode_equal(target, ofnode_get_by_phandle(phandle)));
+	ut_assert(ofnode_equal(target,
+			       oftree_get_by_phandle(oftree_default(),
+						     phandle)));
+
+	/* unknown phandles are not cached */
+	ut_assert(!ofnode_valid(ofnode_get_by_phandle(0x1000000)));
+	ut_assert(!ofnode_valid(ofnode_phandle_cache_find(0x1000000)));
+
+	/* an entry which no longer matches the tree is ignored */
+	ofnode_phandle_cache_add(phandle + 1, target);
+	ut_assert(!ofnode_valid(ofnode_phandle_cache_find(phandle + 1)));
+
+	ofnode_phandle_cache_clear();
+	ut_assert(!ofnode_valid(ofnode_phandle_cache_find(phandle)));
+
+	return 0;
+}
+DM_TEST(dm_test_ofnode_phandle_cache, UTF_SCAN_FDT);
+
 /* test oftree_get_by_phandle() with a the 'other' oftree */
 static int dm_test_ofnode_get_by_phandle_ot(struct unit_test_state *uts)
 {
@@ -186,6 +186,147 @@ static int dm_test_regmap_poll(struct unit_test_state *uts)
 }
 DM_TEST(dm_test_regmap_poll, UTF_SCAN_PDATA | UTF_SCAN_FDT);
 
+/* Read/Write test of bulk access */
+static int dm_test_regmap_bulk(struct unit_test_state *uts)
+{
+	u32 out[4] = { 0x11223344, 0x55667788, 0x99aabbcc, 0xddeeff00 };
+	struct udevice *dev;
+	struct regmap *map;
+	u32 in[4];
+	uint reg;
+	int i;
+
+	sandbox_set_enable_memio(true);
+	ut_assertok(uclass_get_device(UCLASS_SYSCON, 0, &dev));
+	map = syscon_get_regmap(dev);
+	ut_assertok_ptr(map);
+	ut_assert(map->fast_path);
+
+	ut_assertok(regmap_bulk_write(map, 0, out, ARRAY_SIZE(out)));
+	for (i = 0; i < ARRAY_SIZE(out); i++) {
+		ut_assertok(regmap_read(map, i * 4, &reg));
+		ut_asserteq(out[i], reg);
+	}
+
+	memset(in, '\0', sizeof(in));
+	ut_assertok(regmap_bulk_read(map, 0, in, ARRAY_SIZE(in)));
+	ut_asserteq_mem(out, in, sizeof(in));
+
+	ut_assertok(regmap_bulk_read(map, 8, in, 2));
+	ut_asserteq(out[2], in[0]);
+	ut_asserteq(out[3], in[1]);
+
+	/* The map is only 16 bytes long */
+	ut_asserteq(-ERANGE, regmap_bulk_read(map, 4, in, ARRAY_SIZE(in)));
+	ut_asserteq(-ERANGE, regmap_bulk_write(map, 4, out, ARRAY_SIZE(out)));
+
+	return 0;
+}
+DM_TEST(dm_test_regmap_bulk, UTF_SCAN_PDATA | UTF_SCAN_FDT);
+
+/* Test of the register cache */
+static int dm_test_regmap_cache(struct unit_test_state *uts)
+{
+	struct udevice *dev;
+	struct regmap *map;
+	u32 *ptr;
+	uint reg;
+
+	sandbox_set_enable_memio(true);
+	ut_assertok(uclass_get_device(UCLASS_SYSCON, 0, &dev));
+	map = syscon_get_regmap(dev);
+	ut_assertok_ptr(map);
+	ptr = map_sysmem(map->ranges[0].start, map->ranges[0].size);
+
+	ut_assertok(regmap_init_cache(map, 2));
+	ut_assertok(regmap_write(map, 0, 0x12345678));
+	ut_asserteq(0x12345678, ptr[0]);
+
+	/* Reads come from the cache, not the hardware */
+	ptr[0] = 0xcafe;
+	ut_assertok(regmap_read(map, 0, &reg));
+	ut_asserteq(0x12345678, reg);
+
+	/* Registers past the end of the cache are not cached */
+	ut_assertok(regmap_write(map, 8, 0x1111));
+	ptr[2] = 0x2222;
+	ut_assertok(regmap_read(map, 8, &reg));
+	ut_asserteq(0x2222, reg);
+
+	/* Updating a cached register with its current value does nothing */
+	ut_assertok(regmap_update_bits(map, 0, 0xff, 0x78));
+	ut_asserteq(0xcafe, ptr[0]);
+	ut_assertok(regmap_update_bits(map, 0, 0xff, 0x99));
+	ut_asserteq(0x12345699, ptr[0]);
+
+	/* Raw writes drop the register from the cache */
+	ut_assertok(regmap_write(map, 4, 0x3333));
+	ptr[1] = 0;
+	ut_assertok(regmap_read(map, 4, &reg));
+	ut_asserteq(0x3333, reg);
+	reg = 0x4444;
+	ut_assertok(regmap_raw_write(map, 4, &reg, sizeof(reg)));
+	ptr[1] = 0x5555;
+	ut_assertok(regmap_read(map, 4, &reg));
+	ut_asserteq(0x5555, reg);
+
+	/* Dropping the cache makes reads go to the hardware again */
+	ptr[0] = 0x6666;
+	ut_assertok(regmap_read(map, 0, &reg));
+	ut_asserteq(0x12345699, reg);
+	regmap_cache_drop(map);
+	ut_assertok(regmap_read(map, 0, &reg));
+	ut_asserteq(0x6666, reg);
+
+	ut_assertok(regmap_init_cache(map, 0));
+	ut_assertnull(map->cache);
+
+	return 0;
+}
+DM_TEST(dm_test_regmap_cache, UTF_SCAN_PDATA | UTF_SCAN_FDT);
+
+/* Compare the fast path against the generic access functions */
+static int dm_test_regmap_speed(struct unit_test_state *uts)
+{
+	ulong start, raw_us, fast_us;
+	struct udevice *dev;
+	struct regmap *map;
+	uint raw_reg, reg;
+	int i;
+
+	sandbox_set_enable_memio(true);
+	ut_assertok(uclass_get_device(UCLASS_SYSCON, 0, &dev));
+	map = syscon_get_regmap(dev);
+	ut_assertok_ptr(map);
+	ut_assert(map->fast_path);
+
+	/* the fast path must see the same value and keep its range check */
+	ut_assertok(regmap_write(map, 4, 0x12345678));
+	ut_assertok(regmap_raw_read(map, 4, &raw_reg, sizeof(raw_reg)));
+	ut_assertok(regmap_read(map, 4, &reg));
+	ut_asserteq(raw_reg, reg);
+	ut_asserteq(-ERANGE, regmap_read(map, map->ranges[0].size, &reg));
+	ut_asserteq(-ERANGE, regmap_write(map, map->ranges[0].size, 0));
+
+	start = timer_get_us();
+	for (i = 0; i < 10000; i++)
+		ut_assertok(regmap_raw_read(map, 4, &reg, sizeof(reg)));
+	raw_us = timer_get_us() - start;
+
+	start = timer_get_us();
+	for (i = 0; i < 10000; i++)
+		ut_assertok(regmap_read(map, 4, &reg));
+	fast_us = timer_get_us() - start;
+	printf("regmap read x10000: raw %lu us, fast %lu us\n", raw_us,
+	       fast_us);
+
+	/* allow for timer noise, but the fast path must not be much slower */
+	ut_assert(fast_us <= 2 * raw_us + 1000);
+
+	return 0;
+}
+DM_TEST(dm_test_regmap_speed, UTF_SCAN_PDATA | UTF_SCAN_FDT);
+
 struct regmaptest_priv {
 	struct regmap *cfg_regmap; /* For testing regmap_config options. */
 	struct regmap *fld_regmap; /* For testing regmap fields. */
@@ -218,7 +359,7 @@ static int remaptest_probe(struct udevice *dev)
 	struct regmaptest_priv *priv = dev_get_priv(dev);
 	struct regmap *regmap;
 	struct regmap_field *field;
-	struct regmap_config cfg;
+	struct regmap_config cfg = {};
 	int i;
 	static const int n = ARRAY_SIZE(field_cfgs);
 
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for incremental export of the environment
+ */
+
+#include <env.h>
+#include <env_internal.h>
+#include <malloc.h>
+#include <search.h>
+#include <test/env.h>
+#include <test/ut.h>
+#include <u-boot/crc.h>
+
+/* Check that only what changed needs to be written */
+static int env_test_export_incremental(struct unit_test_state *uts)
+{
+	const char *var;
+	bool tail;
+	env_t *env;
+
+	env = malloc(sizeof(env_t));
+	ut_assertnonnull(env);
+	ut_assertok(env_export(env));
+	ut_asserteq(crc32(0, env->data, ENV_SIZE), env->crc);
+	ut_assert(!hdirty_r(&env_htab));
+
+	/* Pretend that it was saved, then export it again unchanged */
+	env_set_stored(true);
+	ut_assertok(env_export(env));
+	ut_asserteq(crc32(0, env->data, ENV_SIZE), env->crc);
+	ut_assert(!env_export_changed(512, CONFIG_ENV_SIZE - 512));
+
+	/* The last region is unchanged if there is room after the new var */
+	ut_assertok(env_set("zzzz_test", "1"));
+	ut_assertok(env_export(env));
+	ut_asserteq(crc32(0, env->data, ENV_SIZE), env->crc);
+	for (var = (char *)env->data; *var; var += strlen(var) + 1) {
+		if (!strcmp(var, "zzzz_test=1"))
+			break;
+	}
+	ut_assert(*var);
+	ut_assert(env_export_changed((void *)var - (void *)env, 1));
+	tail = (void *)var + 12 - (void *)env <= CONFIG_ENV_SIZE - 512;
+	if (tail)
+		ut_assert(!env_export_changed(CONFIG_ENV_SIZE - 1, 1));
+
+	ut_assertok(env_set("zzzz_test", NULL));
+	env_set_stored(false);
+	free(env);
+
+	return 0;
+}
+ENV_TEST(env_test_export_incremental, 0);
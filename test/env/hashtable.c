@@ -6,6 +6,7 @@
 
 #include <command.h>
 #include <log.h>
+#include <malloc.h>
 #include <search.h>
 #include <stdio.h>
 #include <vsprintf.h>
@@ -122,3 +123,114 @@ static int env_test_htab_deletes(struct unit_test_state *uts)
 	return 0;
 }
 ENV_TEST(env_test_htab_deletes, 0);
+
+static struct hsearch_data *import_htab;
+static int import_filled;
+
+/* Record how many entries are present when one is first checked; reject v7 */
+static int htab_import_change_ok(const struct env_entry *item,
+				 const char *newval, enum env_op op, int flag)
+{
+	if (op == env_op_create && !import_filled)
+		import_filled = import_htab->filled;
+
+	return op == env_op_create && !strcmp(item->key, "v7");
+}
+
+/* Import many more variables than the usual table size, in one go */
+static int env_test_htab_import(struct unit_test_state *uts)
+{
+	const int count = 2 * CONFIG_ENV_MAX_ENTRIES;
+	struct hsearch_data htab;
+	struct env_entry item, *ritem;
+	char key[20], *buf, *p;
+	int i;
+
+	buf = malloc(count * 16 + 1);
+	ut_assertnonnull(buf);
+	for (i = 0, p = buf; i < count; i++)
+		p += sprintf(p, "v%d=%d", i, i) + 1;
+	*p++ = '\0';
+
+	memset(&htab, 0, sizeof(htab));
+	htab.change_ok = htab_import_change_ok;
+	import_htab = &htab;
+	import_filled = 0;
+	ut_asserteq(1, himport_r(&htab, buf, p - buf, '\0', 0, 0, 0, NULL));
+	free(buf);
+	if (!IS_ENABLED(CONFIG_ENV_WRITEABLE_LIST))
+		ut_assert_nextline("himport_r: can't insert \"v7=7\" into hash table");
+	ut_assert_console_end();
+
+	/* Checks only happen once everything is imported */
+	ut_asserteq(count, import_filled);
+	ut_asserteq(count - 1, htab.filled);
+	ut_assert(htab.size >= 2 * count);
+
+	for (i = 0; i < count; i++) {
+		sprintf(key, "v%d", i);
+		item.key = key;
+		item.data = NULL;
+		hsearch_r(item, ENV_FIND, &ritem, &htab, 0);
+		if (i == 7) {
+			ut_assertnull(ritem);
+			continue;
+		}
+		ut_assertnonnull(ritem);
+		ut_asserteq(i, simple_strtoul(ritem->data, NULL, 10));
+	}
+
+	hdestroy_r(&htab);
+	return 0;
+}
+ENV_TEST(env_test_htab_import, UTF_CONSOLE);
+
+/* Check tracking of changes and exporting in order */
+static int env_test_htab_export(struct unit_test_state *uts)
+{
+	static const char env[] = "b=2\0a=1\0c=3\0";
+	struct hsearch_data htab;
+	struct env_entry item, *ritem;
+	char *res = NULL;
+
+	memset(&htab, 0, sizeof(htab));
+	ut_asserteq(1, himport_r(&htab, env, sizeof(env), '\0', 0, 0, 0,
+				 NULL));
+	ut_assert(hdirty_r(&htab));
+	hclean_r(&htab);
+	ut_assert(!hdirty_r(&htab));
+
+	ut_assert(hexport_r(&htab, '\n', 0, &res, 0, 0, NULL) > 0);
+	ut_asserteq_str("a=1\nb=2\nc=3\n", res);
+	free(res);
+	ut_assert(htab.sorted_ok);
+	ut_assert(!hdirty_r(&htab));
+
+	/* Changing a value keeps the order of keys */
+	item.key = "b";
+	item.data = "22";
+	ut_assert(hsearch_r(item, ENV_ENTER, &ritem, &htab, 0));
+	ut_assert(hdirty_r(&htab));
+	ut_assert(htab.sorted_ok);
+	res = NULL;
+	ut_assert(hexport_r(&htab, '\n', 0, &res, 0, 0, NULL) > 0);
+	ut_asserteq_str("a=1\nb=22\nc=3\n", res);
+	free(res);
+
+	/* Adding or deleting a variable means sorting again */
+	hclean_r(&htab);
+	item.key = "aa";
+	item.data = "4";
+	ut_assert(hsearch_r(item, ENV_ENTER, &ritem, &htab, 0));
+	ut_assert(hdirty_r(&htab));
+	ut_assert(!htab.sorted_ok);
+	ut_asserteq(0, hdelete_r("c", &htab, 0));
+	res = NULL;
+	ut_assert(hexport_r(&htab, '\n', 0, &res, 0, 0, NULL) > 0);
+	ut_asserteq_str("a=1\naa=4\nb=22\n", res);
+	free(res);
+
+	hdestroy_r(&htab);
+	return 0;
+}
+ENV_TEST(env_test_htab_export, 0);
@@ -11,6 +11,7 @@
 #include <log.h>
 #include <malloc.h>
 #include <mapmem.h>
+#include <time.h>
 #include <asm/io.h>
 
 #include <u-boot/lz4.h>
@@ -472,6 +473,53 @@ static int compression_test_gzip(struct unit_test_state *uts)
 }
 LIB_TEST(compression_test_gzip, 0);
 
+/*
+ * Check matches at short and long distances, since inflate copies them in
+ * different ways
+ */
+static int compression_test_gzip_matches(struct unit_test_state *uts)
+{
+	const ulong size = 0x20000;
+	ulong comp_size, out_size;
+	uint seed = 1, dist, len;
+	u8 *buf, *comp, *out;
+	ulong pos;
+	int i;
+
+	buf = malloc(size);
+	ut_assertnonnull(buf);
+	comp = malloc(size * 2);
+	ut_assertnonnull(comp);
+	out = malloc(size);
+	ut_assertnonnull(out);
+
+	/* A few random bytes, then a repeat of earlier data, over and over */
+	for (i = 0, pos = 0; pos < size; i++) {
+		for (len = i % 5; len && pos < size; len--) {
+			seed = seed * 1103515245 + 12345;
+			buf[pos++] = seed >> 24;
+		}
+		dist = i % 3 ? (seed >> 8) % 20000 + 1 : i % 12 + 1;
+		len = (seed >> 4) % 256 + 3;
+		for (; dist <= pos && len && pos < size; len--, pos++)
+			buf[pos] = buf[pos - dist];
+	}
+
+	comp_size = size * 2;
+	ut_assertok(gzip(comp, &comp_size, buf, size));
+	out_size = comp_size;
+	ut_assertok(gunzip(out, size, comp, &out_size));
+	ut_asserteq(size, out_size);
+	ut_asserteq_mem(buf, out, size);
+
+	free(out);
+	free(comp);
+	free(buf);
+
+	return 0;
+}
+LIB_TEST(compression_test_gzip_matches, 0);
+
 static int compression_test_bzip2(struct unit_test_state *uts)
 {
 	return run_test(uts, "bzip2", compress_using_bzip2,
@@ -505,6 +553,65 @@ static int compression_test_zstd(struct unit_test_state *uts)
 }
 LIB_TEST(compression_test_zstd, 0);
 
+/* Check that all frames are decompressed, as written by pzstd */
+static int compression_test_zstd_frames(struct unit_test_state *uts)
+{
+	char in[sizeof(zstd_compressed) * 2 + 4], out[sizeof(plain) * 2];
+	ulong size = zstd_compressed_size;
+	ulong plain_size = strlen(plain);
+	struct abuf in_buf, out_buf;
+
+	/* Two frames followed by some junk, which should be ignored */
+	memcpy(in, zstd_compressed, size);
+	memcpy(in + size, zstd_compressed, size);
+	memset(in + size * 2, '\xff', 4);
+	abuf_init_set(&in_buf, in, size * 2 + 4);
+	abuf_init_set(&out_buf, out, sizeof(out));
+
+	ut_asserteq(plain_size * 2, zstd_decompress(&in_buf, &out_buf));
+	ut_asserteq_mem(plain, out, plain_size);
+	ut_asserteq_mem(plain, out + plain_size, plain_size);
+
+	return 0;
+}
+LIB_TEST(compression_test_zstd_frames, 0);
+
+/* Report the decompression speed, to compare the zstd build profiles */
+static int compression_test_zstd_speed(struct unit_test_state *uts)
+{
+	const int frames = 32, loops = 100;
+	ulong size = zstd_compressed_size;
+	ulong plain_size = strlen(plain);
+	struct abuf in_buf, out_buf;
+	ulong start, us;
+	char *in, *out;
+	int i;
+
+	in = malloc(size * frames);
+	ut_assertnonnull(in);
+	out = malloc(plain_size * frames);
+	ut_assertnonnull(out);
+	for (i = 0; i < frames; i++)
+		memcpy(in + size * i, zstd_compressed, size);
+	abuf_init_set(&in_buf, in, size * frames);
+	abuf_init_set(&out_buf, out, plain_size * frames);
+
+	start = timer_get_us();
+	for (i = 0; i < loops; i++)
+		ut_asserteq(plain_size * frames,
+			    zstd_decompress(&in_buf, &out_buf));
+	us = timer_get_us() - start;
+	printf("zstd %s: %d x %lu bytes in %lu us\n",
+	       IS_ENABLED(CONFIG_ZSTD_LIB_FAST) ? "fast" :
+	       IS_ENABLED(CONFIG_ZSTD_LIB_FULL) ? "full" : "minify", loops,
+	       plain_size * frames, us);
+	free(out);
+	free(in);
+
+	return 0;
+}
+LIB_TEST(compression_test_zstd_speed, 0);
+
 static int compress_using_none(struct unit_test_state *uts,
 			       void *in, unsigned long in_size,
 			       void *out, unsigned long out_max,
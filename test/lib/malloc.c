@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Tests for malloc() with many small blocks
+ */
+
+#include <malloc.h>
+#include <time.h>
+#include <test/lib.h>
+#include <test/test.h>
+#include <test/ut.h>
+
+#define CHURN_LIVE	256
+#define CHURN_LOOPS	100000
+
+/* Check that freed small blocks are reused and accounted for */
+static int lib_malloc_small(struct unit_test_state *uts)
+{
+	struct malloc_info before, after;
+	void *ptr[8];
+	void *first;
+	int i;
+
+	malloc_get_info(&before);
+	for (i = 0; i < ARRAY_SIZE(ptr); i++) {
+		ptr[i] = malloc(40);
+		ut_assertnonnull(ptr[i]);
+	}
+	first = ptr[ARRAY_SIZE(ptr) - 1];
+	for (i = 0; i < ARRAY_SIZE(ptr); i++)
+		free(ptr[i]);
+
+	malloc_get_info(&after);
+	ut_asserteq(before.malloc_count + ARRAY_SIZE(ptr), after.malloc_count);
+	ut_asserteq(before.free_count + ARRAY_SIZE(ptr), after.free_count);
+	ut_asserteq(before.in_use_bytes, after.in_use_bytes);
+	ut_asserteq(after.total_bytes, after.in_use_bytes + after.free_bytes +
+		    after.small_bytes);
+	ut_assert(after.largest_free <= after.free_bytes);
+
+	if (!IS_ENABLED(CONFIG_SYS_MALLOC_SMALL))
+		return 0;
+
+	/* The block freed last comes back first */
+	ut_asserteq_ptr(first, malloc(40));
+	free(first);
+	malloc_get_info(&after);
+	ut_asserteq(before.small_hits + 1, after.small_hits);
+	ut_assert(after.small_chunks >= ARRAY_SIZE(ptr));
+
+	return 0;
+}
+LIB_TEST(lib_malloc_small, 0);
+
+/**
+ * lib_malloc_churn() - test many small malloc() and free() calls
+ *
+ * Keep a set of blocks of assorted small sizes, repeatedly replacing one of
+ * them, as a network stack or filesystem does. Most of the allocations should
+ * be served from the blocks kept back by free().
+ *
+ * @uts:	unit test state
+ * Return:	0 = success, 1 = failure
+ */
+static int lib_malloc_churn(struct unit_test_state *uts)
+{
+	struct malloc_info before, after;
+	void **live;
+	ulong start, us;
+	u32 seed = 1;
+	int i, slot;
+
+	live = calloc(CHURN_LIVE, sizeof(*live));
+	ut_assertnonnull(live);
+	malloc_get_info(&before);
+
+	start = timer_get_us();
+	for (i = 0; i < CHURN_LOOPS; i++) {
+		seed = seed * 1103515245 + 12345;
+		slot = (seed >> 8) % CHURN_LIVE;
+		free(live[slot]);
+		live[slot] = malloc(16 + (seed >> 20) % 497);
+		ut_assertnonnull(live[slot]);
+	}
+	us = timer_get_us() - start;
+
+	for (i = 0; i < CHURN_LIVE; i++)
+		free(live[i]);
+	malloc_get_info(&after);
+	free(live);
+
+	ut_asserteq(before.in_use_bytes, after.in_use_bytes);
+	printf("malloc: %d malloc/free pairs in %lu us (%lu/s), %lu cache hits\n",
+	       CHURN_LOOPS, us, us ? CHURN_LOOPS * 1000000UL / us : 0,
+	       after.small_hits - before.small_hits);
+	if (IS_ENABLED(CONFIG_SYS_MALLOC_SMALL))
+		ut_assert(after.small_hits - before.small_hits >=
+			  CHURN_LOOPS / 2);
+	else
+		ut_asserteq(before.small_hits, after.small_hits);
+
+	return 0;
+}
+LIB_TEST(lib_malloc_churn, 0);
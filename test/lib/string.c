@@ -20,8 +20,8 @@
 #define MASK 0xA5
 /* Number of different alignment values */
 #define SWEEP 16
-/* Allow for copying up to 32 bytes */
-#define BUFLEN (SWEEP + 33)
+/* Allow for copying up to 64 bytes, past the length using vector routines */
+#define BUFLEN (SWEEP + 65)
 
 #define TEST_STR	"hello"
 
@@ -8,6 +8,7 @@
 #include <command.h>
 #include <hexdump.h>
 #include <rand.h>
+#include <time.h>
 #include <uboot_aes.h>
 #include <test/lib.h>
 #include <test/test.h>
@@ -164,3 +165,33 @@ static int lib_test_aes(struct unit_test_state *uts)
 	return ret;
 }
 LIB_TEST(lib_test_aes, 0);
+
+/* Report the CBC decryption speed, which matters when booting ciphered FITs */
+static int lib_test_aes_speed(struct unit_test_state *uts)
+{
+	const int num_block = 0x10000 / AES_BLOCK_LENGTH;
+	u8 key[AES256_KEY_LENGTH], key_exp[AES256_EXPAND_KEY_LENGTH];
+	u8 iv[AES_BLOCK_LENGTH];
+	u8 *src, *dst;
+	ulong start;
+
+	src = malloc(num_block * AES_BLOCK_LENGTH);
+	ut_assertnonnull(src);
+	dst = malloc(num_block * AES_BLOCK_LENGTH);
+	ut_assertnonnull(dst);
+	rand_buf(key, sizeof(key));
+	rand_buf(iv, sizeof(iv));
+	rand_buf(src, num_block * AES_BLOCK_LENGTH);
+	aes_expand_key(key, AES256_KEY_LENGTH, key_exp);
+
+	start = timer_get_us();
+	aes_cbc_decrypt_blocks(AES256_KEY_LENGTH, key_exp, iv, src, dst,
+			       num_block);
+	printf("aes256-cbc decrypt: %d bytes in %lu us\n",
+	       num_block * AES_BLOCK_LENGTH, timer_get_us() - start);
+	free(dst);
+	free(src);
+
+	return 0;
+}
+LIB_TEST(lib_test_aes_speed, 0);
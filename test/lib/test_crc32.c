@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Unit test for crc32
+ *
+ * The CRC is worked out a byte or a register at a time, depending on the
+ * architecture and the alignment of the data, so check that every split
+ * gives the same result as the bitwise definition.
+ */
+
+#include <test/lib.h>
+#include <test/ut.h>
+#include <u-boot/crc.h>
+
+#define CRC32_BUFLEN	96
+
+static u32 crc32_bitwise(u32 crc, const u8 *buf, uint len)
+{
+	int i;
+
+	crc = ~crc;
+	while (len--) {
+		crc ^= *buf++;
+		for (i = 0; i < 8; i++)
+			crc = crc & 1 ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+	}
+
+	return ~crc;
+}
+
+static int lib_crc32(struct unit_test_state *uts)
+{
+	u8 buf[CRC32_BUFLEN];
+	int offset, len, i;
+
+	ut_asserteq(0xcbf43926, crc32(0, (u8 *)"123456789", 9));
+
+	for (i = 0; i < CRC32_BUFLEN; i++)
+		buf[i] = i * 37 + 11;
+	for (offset = 0; offset < 16; offset++) {
+		for (len = 0; len <= CRC32_BUFLEN - offset; len++) {
+			ut_asserteq(crc32_bitwise(0, buf + offset, len),
+				    crc32(0, buf + offset, len));
+		}
+	}
+
+	/* Continuing a CRC must match doing it in one go */
+	ut_asserteq(crc32(0, buf, CRC32_BUFLEN),
+		    crc32(crc32(0, buf, 13), buf + 13, CRC32_BUFLEN - 13));
+
+	return 0;
+}
+LIB_TEST(lib_crc32, 0);
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Unit tests for sha512 functions
+ */
+
+#include <malloc.h>
+#include <time.h>
+#include <test/lib.h>
+#include <test/test.h>
+#include <test/ut.h>
+#include <u-boot/sha512.h>
+
+/* FIPS 180-2 examples: "abc" and one million repetitions of 'a' */
+static const u8 expected_abc[SHA512_SUM_LEN] = {
+	0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba,
+	0xcc, 0x41, 0x73, 0x49, 0xae, 0x20, 0x41, 0x31,
+	0x12, 0xe6, 0xfa, 0x4e, 0x89, 0xa9, 0x7e, 0xa2,
+	0x0a, 0x9e, 0xee, 0xe6, 0x4b, 0x55, 0xd3, 0x9a,
+	0x21, 0x92, 0x99, 0x2a, 0x27, 0x4f, 0xc1, 0xa8,
+	0x36, 0xba, 0x3c, 0x23, 0xa3, 0xfe, 0xeb, 0xbd,
+	0x45, 0x4d, 0x44, 0x23, 0x64, 0x3c, 0xe8, 0x0e,
+	0x2a, 0x9a, 0xc9, 0x4f, 0xa5, 0x4c, 0xa4, 0x9f,
+};
+
+static const u8 expected_million_a[SHA512_SUM_LEN] = {
+	0xe7, 0x18, 0x48, 0x3d, 0x0c, 0xe7, 0x69, 0x64,
+	0x4e, 0x2e, 0x42, 0xc7, 0xbc, 0x15, 0xb4, 0x63,
+	0x8e, 0x1f, 0x98, 0xb1, 0x3b, 0x20, 0x44, 0x28,
+	0x56, 0x32, 0xa8, 0x03, 0xaf, 0xa9, 0x73, 0xeb,
+	0xde, 0x0f, 0xf2, 0x44, 0x87, 0x7e, 0xa6, 0x0a,
+	0x4c, 0xb0, 0x43, 0x2c, 0xe5, 0x77, 0xc3, 0x1b,
+	0xeb, 0x00, 0x9c, 0x5c, 0x2c, 0x49, 0xaa, 0x2e,
+	0x4e, 0xad, 0xb2, 0x17, 0xad, 0x8c, 0xc0, 0x9b,
+};
+
+/*
+ * Check the digest of a short and a long message, and report how long the
+ * long one takes, to compare accelerated and portable code
+ */
+static int lib_test_sha512(struct unit_test_state *uts)
+{
+	const int size = 1000000;
+	u8 output[SHA512_SUM_LEN];
+	ulong start;
+	u8 *buf;
+
+	sha512_csum_wd((const u8 *)"abc", 3, output, CHUNKSZ_SHA512);
+	ut_asserteq_mem(expected_abc, output, SHA512_SUM_LEN);
+
+	buf = malloc(size);
+	ut_assertnonnull(buf);
+	memset(buf, 'a', size);
+	start = timer_get_us();
+	sha512_csum_wd(buf, size, output, CHUNKSZ_SHA512);
+	printf("sha512: %d bytes in %lu us\n", size, timer_get_us() - start);
+	ut_asserteq_mem(expected_million_a, output, SHA512_SUM_LEN);
+	free(buf);
+
+	return 0;
+}
+LIB_TEST(lib_test_sha512, 0);
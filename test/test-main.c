@@ -111,6 +111,8 @@ static int dm_test_pre_run(struct unit_test_state *uts)
 		uts->fdt_chksum = crc8(0, gd->fdt_blob,
 				       fdt_totalsize(gd->fdt_blob));
 	gd->dm_root = NULL;
+	/* Don't let nodes recorded by a previous test, or by sandbox, leak in */
+	dm_lazy_uninit();
 	malloc_disable_testing();
 	if (CONFIG_IS_ENABLED(UT_DM) && !CONFIG_IS_ENABLED(OF_PLATDATA))
 		memset(dm_testdrv_op_count, '\0', sizeof(dm_testdrv_op_count));
@@ -290,6 +292,7 @@ static int dm_test_restore(struct device_node *of_root)
 
 	gd_set_of_root(of_root);
 	gd->dm_root = NULL;
+	dm_lazy_uninit();
 	ret = dm_init(CONFIG_IS_ENABLED(OF_LIVE));
 	if (ret)
 		return ret;
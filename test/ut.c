@@ -11,6 +11,7 @@
 #include <asm/state.h>
 #endif
 #include <asm/global_data.h>
+#include <dm/root.h>
 #include <test/test.h>
 #include <test/ut.h>
 
@@ -41,8 +42,19 @@ void ut_failf(struct unit_test_state *uts, const char *fname, int line,
 ulong ut_check_free(void)
 {
 	struct mallinfo info = mallinfo();
+	ulong used = info.uordblks;
 
-	return info.uordblks;
+	/* Free objects in the driver-model pools are not in use */
+	if (CONFIG_IS_ENABLED(DM_POOL)) {
+		struct dm_pool_stats stats[DM_POOL_COUNT];
+		int i;
+
+		dm_pool_get_stats(stats);
+		for (i = 0; i < DM_POOL_COUNT; i++)
+			used -= (stats[i].total - stats[i].used) * stats[i].size;
+	}
+
+	return used;
 }
 
 long ut_check_delta(ulong last)